@@ -0,0 +1,193 @@
+#include "airporttrafficmodel.h"
+#include <QVarLengthArray>
+#include <algorithm>
+
+
+AirportTrafficModel::AirportTrafficModel(FlightModel* model, QObject* parent)
+    : QAbstractTableModel(parent), m_model(model)
+{
+    const auto& airports = airportCatalog();
+    for (auto it = airports.cbegin(); it != airports.cend(); ++it) {
+        Row r;
+        r.airportId = it.key();
+        r.info      = it.value();
+        m_rows.push_back(r);
+    }
+    std::sort(m_rows.begin(), m_rows.end(), [](const Row& a, const Row& b){ return a.info.name < b.info.name; });
+    for (int i = 0; i < m_rows.size(); ++i)
+        m_rowById.insert(m_rows[i].airportId, i);
+
+    connect(m_model, &FlightModel::routeChanged,        this, &AirportTrafficModel::onRouteChanged);
+    connect(m_model, &QAbstractItemModel::modelReset,   this, &AirportTrafficModel::rebuild);
+
+    rebuild();
+}
+
+int AirportTrafficModel::rowCount(const QModelIndex& parent) const
+{
+    if (parent.isValid()) return 0;
+    return m_rows.size();
+}
+
+int AirportTrafficModel::columnCount(const QModelIndex& parent) const
+{
+    if (parent.isValid()) return 0;
+    return ColumnCount;
+}
+
+QVariant AirportTrafficModel::data(const QModelIndex& idx, int role) const
+{
+    if (!idx.isValid() || idx.row() < 0 || idx.row() >= m_rows.size()) return {};
+
+    const Row& r = m_rows[idx.row()];
+
+    if (role == Qt::DisplayRole) {
+        switch (idx.column()) {
+        case AirportColumn:  return r.info.name;
+        case InboundColumn:  return r.inbound;
+        case OutboundColumn: return r.outbound;
+        case EnRouteColumn:  return r.enRoute;
+        case ArrivedColumn:  return r.arrived;
+        case RecentColumn:   return recentText(r).join(QStringLiteral(", "));
+        default:             return {};
+        }
+    }
+
+    switch (role) {
+    case Qt::ToolTipRole:      return r.info.name + QStringLiteral(" · ") + r.info.country;
+    case AirportIdRole:        return int(r.airportId);
+    case NameRole:             return r.info.name;
+    case CountryRole:          return r.info.country;
+    case LatitudeRole:         return r.info.latitude;
+    case LongitudeRole:        return r.info.longitude;
+    case InboundRole:          return r.inbound;
+    case OutboundRole:         return r.outbound;
+    case EnRouteRole:          return r.enRoute;
+    case ArrivedRole:          return r.arrived;
+    case RecentArrivalsRole:   return recentText(r);
+    default:                   return {};
+    }
+}
+
+QVariant AirportTrafficModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole)
+        return QAbstractTableModel::headerData(section, orientation, role);
+
+    switch (section) {
+    case AirportColumn:  return QStringLiteral("Airport");
+    case InboundColumn:  return QStringLiteral("Inbound");
+    case OutboundColumn: return QStringLiteral("Outbound");
+    case EnRouteColumn:  return QStringLiteral("En route");
+    case ArrivedColumn:  return QStringLiteral("Arrived");
+    case RecentColumn:   return QStringLiteral("Recent arrivals");
+    default:             return {};
+    }
+}
+
+QHash<int, QByteArray> AirportTrafficModel::roleNames() const
+{
+    return {
+        {AirportIdRole, "airportId"},
+        {NameRole, "name"},
+        {CountryRole, "country"},
+        {LatitudeRole, "latitude"},
+        {LongitudeRole, "longitude"},
+        {InboundRole, "inbound"},
+        {OutboundRole, "outbound"},
+        {EnRouteRole, "enRoute"},
+        {ArrivedRole, "arrived"},
+        {RecentArrivalsRole, "recentArrivals"},
+    };
+}
+
+void AirportTrafficModel::apply(const FlightModel::RouteState& s, int sign)
+{
+    if (!s.exists)
+        return;
+
+    const int dst = m_rowById.value(s.dst, -1);
+    if (dst >= 0) {
+        if (s.arrived) m_rows[dst].arrived += sign;
+        else           m_rows[dst].inbound += sign;
+    }
+
+    const int src = m_rowById.value(s.src, -1);
+    if (src >= 0) {
+        m_rows[src].outbound += sign;
+        if (!s.arrived)
+            m_rows[src].enRoute += sign;
+    }
+}
+
+void AirportTrafficModel::touch(quint8 airportId)
+{
+    const int row = m_rowById.value(airportId, -1);
+    if (row >= 0)
+        emit dataChanged(index(row, 0), index(row, ColumnCount - 1));
+}
+
+void AirportTrafficModel::onRouteChanged(int row, const FlightModel::RouteState& before, const FlightModel::RouteState& after)
+{
+    apply(before, -1);
+    apply(after, +1);
+
+    const bool justArrived = after.arrived && (!before.exists || !before.arrived);
+    if (justArrived) {
+        const int dst = m_rowById.value(after.dst, -1);
+        const FlightModel::Item* it = m_model->item(row);
+        if (dst >= 0 && it) {
+            QVector<Arrival>& recent = m_rows[dst].recent;
+            recent.prepend({ it->rec.flightId, it->lastSeen });
+            if (recent.size() > kRecentArrivals)
+                recent.resize(kRecentArrivals);
+        }
+    }
+
+    QVarLengthArray<quint8, 4> touched;
+    auto mark = [&](quint8 id){ if (!touched.contains(id)) touched.push_back(id); };
+    if (before.exists) {
+        mark(before.src);
+        mark(before.dst);
+    }
+    mark(after.src);
+    mark(after.dst);
+
+    for (quint8 id : touched)
+        touch(id);
+}
+
+void AirportTrafficModel::rebuild()
+{
+    beginResetModel();
+
+    for (Row& r : m_rows) {
+        r.inbound = r.outbound = r.enRoute = r.arrived = 0;
+        r.recent.clear();
+    }
+
+    QVector<const FlightModel::Item*> arrivals;
+    for (const FlightModel::Item& it : m_model->items()) {
+        apply(FlightModel::routeOf(it), +1);
+        if (it.arrived)
+            arrivals.push_back(&it);
+    }
+
+    std::sort(arrivals.begin(), arrivals.end(),
+              [](const FlightModel::Item* a, const FlightModel::Item* b){ return a->lastSeen > b->lastSeen; });
+    for (const FlightModel::Item* it : arrivals) {
+        const int dst = m_rowById.value(it->rec.dstAirportId, -1);
+        if (dst >= 0 && m_rows[dst].recent.size() < kRecentArrivals)
+            m_rows[dst].recent.push_back({ it->rec.flightId, it->lastSeen });
+    }
+
+    endResetModel();
+}
+
+QStringList AirportTrafficModel::recentText(const Row& r) const
+{
+    QStringList out;
+    for (const Arrival& a : r.recent)
+        out << QStringLiteral("%1 %2").arg(a.flightId).arg(a.when.toLocalTime().toString(QStringLiteral("HH:mm")));
+    return out;
+}
@@ -0,0 +1,83 @@
+#ifndef AIRPORTTRAFFICMODEL_H
+#define AIRPORTTRAFFICMODEL_H
+
+#pragma once
+#include <QAbstractTableModel>
+#include <QVector>
+#include <QHash>
+#include <QDateTime>
+#include "flightmodel.h"
+
+// Per-airport traffic counters, one row per airportCatalog() entry, kept
+// up to date from FlightModel::routeChanged in O(1) per update.
+//
+//   inbound  : heading to the airport, not arrived yet
+//   arrived  : arrived at the airport
+//   outbound : departed from the airport (all)
+//   enRoute  : departed from the airport and still airborne
+class AirportTrafficModel : public QAbstractTableModel {
+    Q_OBJECT
+public:
+    enum Columns {
+        AirportColumn,
+        InboundColumn,
+        OutboundColumn,
+        EnRouteColumn,
+        ArrivedColumn,
+        RecentColumn,
+        ColumnCount
+    };
+
+    enum Roles {
+        AirportIdRole = Qt::UserRole + 1,
+        NameRole,
+        CountryRole,
+        LatitudeRole,
+        LongitudeRole,
+        InboundRole,
+        OutboundRole,
+        EnRouteRole,
+        ArrivedRole,
+        RecentArrivalsRole,
+    };
+
+    static constexpr int kRecentArrivals = 5;
+
+    explicit AirportTrafficModel(FlightModel* model, QObject* parent=nullptr);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+private slots:
+    void onRouteChanged(int row, const FlightModel::RouteState& before, const FlightModel::RouteState& after);
+    void rebuild();
+
+private:
+    struct Arrival {
+        quint32   flightId = 0;
+        QDateTime when;
+    };
+
+    struct Row {
+        quint8 airportId = 0;
+        AirportInfo info;
+        int inbound = 0;
+        int outbound = 0;
+        int enRoute = 0;
+        int arrived = 0;
+        QVector<Arrival> recent;   // newest first
+    };
+
+    void apply(const FlightModel::RouteState& s, int sign);
+    void touch(quint8 airportId);
+    QStringList recentText(const Row& r) const;
+
+    FlightModel*       m_model;
+    QVector<Row>       m_rows;
+    QHash<quint8, int> m_rowById;
+};
+
+#endif // AIRPORTTRAFFICMODEL_H
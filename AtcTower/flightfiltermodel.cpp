@@ -0,0 +1,140 @@
+#include "flightfiltermodel.h"
+#include "flightmodel.h"
+#include <algorithm>
+
+
+FlightFilterModel::FlightFilterModel(FlightModel* model, QObject* parent)
+    : QAbstractProxyModel(parent), m_model(model)
+{
+    QAbstractProxyModel::setSourceModel(m_model);
+
+    connect(m_model, &QAbstractItemModel::rowsInserted, this, &FlightFilterModel::onSourceRowsInserted);
+    connect(m_model, &QAbstractItemModel::dataChanged,  this, &FlightFilterModel::onSourceDataChanged);
+    connect(m_model, &QAbstractItemModel::modelAboutToBeReset, this, &FlightFilterModel::onSourceAboutToBeReset);
+    connect(m_model, &QAbstractItemModel::modelReset,   this, &FlightFilterModel::onSourceReset);
+    connect(m_model, &FlightModel::indexKeysChanged,    this, &FlightFilterModel::onIndexKeysChanged);
+
+    m_rows = m_model->flightIndex().query(m_query);
+}
+
+QModelIndex FlightFilterModel::index(int row, int column, const QModelIndex& parent) const
+{
+    if (parent.isValid() || column != 0 || row < 0 || row >= m_rows.size())
+        return {};
+    return createIndex(row, column);
+}
+
+QModelIndex FlightFilterModel::parent(const QModelIndex&) const
+{
+    return {};
+}
+
+int FlightFilterModel::rowCount(const QModelIndex& parent) const
+{
+    if (parent.isValid()) return 0;
+    return m_rows.size();
+}
+
+int FlightFilterModel::columnCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : 1;
+}
+
+QModelIndex FlightFilterModel::mapToSource(const QModelIndex& proxyIndex) const
+{
+    if (!proxyIndex.isValid() || proxyIndex.row() >= m_rows.size())
+        return {};
+    return m_model->index(m_rows[proxyIndex.row()], 0);
+}
+
+QModelIndex FlightFilterModel::mapFromSource(const QModelIndex& sourceIndex) const
+{
+    if (!sourceIndex.isValid())
+        return {};
+    const int row = proxyRowOf(sourceIndex.row());
+    return row < 0 ? QModelIndex() : index(row, 0);
+}
+
+int FlightFilterModel::proxyRowOf(int sourceRow) const
+{
+    const auto it = std::lower_bound(m_rows.cbegin(), m_rows.cend(), sourceRow);
+    if (it == m_rows.cend() || *it != sourceRow)
+        return -1;
+    return int(it - m_rows.cbegin());
+}
+
+void FlightFilterModel::setQuery(const FlightQuery& q)
+{
+    m_remapping = true;
+    beginResetModel();
+    m_query = q;
+    m_rows  = m_model->flightIndex().query(m_query);
+    endResetModel();
+    m_remapping = false;
+}
+
+void FlightFilterModel::onSourceRowsInserted(const QModelIndex& parent, int first, int last)
+{
+    if (parent.isValid())
+        return;
+
+    // FlightModel only appends, so accepted rows always go at the end.
+    QVector<int> accepted;
+    for (int r = first; r <= last; ++r)
+        if (m_model->flightIndex().matches(r, m_query))
+            accepted.push_back(r);
+
+    if (accepted.isEmpty())
+        return;
+
+    beginInsertRows(QModelIndex(), m_rows.size(), m_rows.size() + accepted.size() - 1);
+    m_rows += accepted;
+    endInsertRows();
+}
+
+void FlightFilterModel::onSourceDataChanged(const QModelIndex& topLeft, const QModelIndex& bottomRight, const QVector<int>& roles)
+{
+    const auto lo = std::lower_bound(m_rows.cbegin(), m_rows.cend(), topLeft.row());
+    const auto hi = std::upper_bound(lo, m_rows.cend(), bottomRight.row());
+    if (lo == hi)
+        return;
+
+    emit dataChanged(index(int(lo - m_rows.cbegin()), 0),
+                     index(int(hi - m_rows.cbegin()) - 1, 0), roles);
+}
+
+// The proxy reset brackets the source reset, so views never see the old
+// rows mapped onto the new source.
+void FlightFilterModel::onSourceAboutToBeReset()
+{
+    m_remapping = true;
+    beginResetModel();
+    m_rows.clear();
+}
+
+void FlightFilterModel::onSourceReset()
+{
+    m_rows = m_model->flightIndex().query(m_query);
+    endResetModel();
+    m_remapping = false;
+}
+
+void FlightFilterModel::onIndexKeysChanged(int row)
+{
+    const bool want = m_model->flightIndex().matches(row, m_query);
+    const auto it   = std::lower_bound(m_rows.begin(), m_rows.end(), row);
+    const bool have = (it != m_rows.end() && *it == row);
+    const int  pos  = int(it - m_rows.begin());
+
+    if (want && !have) {
+        beginInsertRows(QModelIndex(), pos, pos);
+        m_rows.insert(pos, row);
+        endInsertRows();
+    } else if (!want && have) {
+        m_remapping = true;
+        beginRemoveRows(QModelIndex(), pos, pos);
+        m_rows.remove(pos);
+        endRemoveRows();
+        m_remapping = false;
+    }
+}
@@ -0,0 +1,49 @@
+#ifndef FLIGHTFILTERMODEL_H
+#define FLIGHTFILTERMODEL_H
+
+#pragma once
+#include <QAbstractProxyModel>
+#include <QVector>
+#include "flightindex.h"
+
+class FlightModel;
+
+// Filtered view of FlightModel driven by its FlightIndex. Unlike a
+// QSortFilterProxyModel it never re-runs the filter on dataChanged: rows
+// only enter or leave when FlightModel reports a bucket change.
+class FlightFilterModel : public QAbstractProxyModel {
+    Q_OBJECT
+public:
+    explicit FlightFilterModel(FlightModel* model, QObject* parent=nullptr);
+
+    QModelIndex index(int row, int column, const QModelIndex& parent = QModelIndex()) const override;
+    QModelIndex parent(const QModelIndex& child) const override;
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QModelIndex mapToSource(const QModelIndex& proxyIndex) const override;
+    QModelIndex mapFromSource(const QModelIndex& sourceIndex) const override;
+
+    const FlightQuery& query() const { return m_query; }
+    void setQuery(const FlightQuery& q);
+
+    // True while rows are being removed or reset because of the filter, so
+    // views' current-index fallout can be told apart from user selection.
+    bool isRemapping() const { return m_remapping; }
+
+private slots:
+    void onSourceRowsInserted(const QModelIndex& parent, int first, int last);
+    void onSourceDataChanged(const QModelIndex& topLeft, const QModelIndex& bottomRight, const QVector<int>& roles);
+    void onSourceAboutToBeReset();
+    void onSourceReset();
+    void onIndexKeysChanged(int row);
+
+private:
+    int proxyRowOf(int sourceRow) const;
+
+    FlightModel* m_model;
+    FlightQuery  m_query;
+    QVector<int> m_rows;   // ascending source rows
+    bool         m_remapping = false;
+};
+
+#endif // FLIGHTFILTERMODEL_H
@@ -0,0 +1,134 @@
+#include "flightindex.h"
+#include <algorithm>
+
+
+static QString classOf(quint8 typeId)
+{
+    return aircraftCatalog().value(typeId).type;
+}
+
+void FlightIndex::clear()
+{
+    m_bySrc.clear();
+    m_byDst.clear();
+    m_byType.clear();
+    m_byClass.clear();
+    m_byBand.clear();
+    m_byIdText.clear();
+    m_keys.clear();
+    m_ids.clear();
+}
+
+void FlightIndex::insert(int row, quint32 flightId, const Keys& k)
+{
+    if (row >= m_keys.size()) {
+        m_keys.resize(row + 1);
+        m_ids.resize(row + 1);
+    }
+    m_keys[row] = k;
+    m_ids[row]  = flightId;
+
+    m_bySrc[k.src].insert(row);
+    m_byDst[k.dst].insert(row);
+    m_byType[k.type].insert(row);
+    m_byClass[classOf(k.type)].insert(row);
+    m_byBand[k.band].insert(row);
+    m_byIdText.insert(QString::number(flightId), row);
+}
+
+bool FlightIndex::update(int row, const Keys& now)
+{
+    if (row < 0 || row >= m_keys.size())
+        return false;
+
+    Keys& old = m_keys[row];
+    bool moved = false;
+
+    if (old.src != now.src) {
+        m_bySrc[old.src].remove(row);
+        m_bySrc[now.src].insert(row);
+        moved = true;
+    }
+    if (old.dst != now.dst) {
+        m_byDst[old.dst].remove(row);
+        m_byDst[now.dst].insert(row);
+        moved = true;
+    }
+    if (old.type != now.type) {
+        m_byType[old.type].remove(row);
+        m_byType[now.type].insert(row);
+        const QString oldClass = classOf(old.type);
+        const QString newClass = classOf(now.type);
+        if (oldClass != newClass) {
+            m_byClass[oldClass].remove(row);
+            m_byClass[newClass].insert(row);
+        }
+        moved = true;
+    }
+    if (old.band != now.band) {
+        m_byBand[old.band].remove(row);
+        m_byBand[now.band].insert(row);
+        moved = true;
+    }
+
+    old = now;
+    return moved;
+}
+
+bool FlightIndex::matches(int row, const FlightQuery& q) const
+{
+    if (row < 0 || row >= m_keys.size())
+        return false;
+
+    const Keys& k = m_keys[row];
+    if (q.srcAirportId >= 0 && k.src != q.srcAirportId) return false;
+    if (q.dstAirportId >= 0 && k.dst != q.dstAirportId) return false;
+    if (q.typeId >= 0 && k.type != q.typeId) return false;
+    if (q.altitudeBand >= 0 && k.band != q.altitudeBand) return false;
+    if (!q.typeClass.isEmpty() && classOf(k.type) != q.typeClass) return false;
+    if (!q.idPrefix.isEmpty() && !QString::number(m_ids[row]).startsWith(q.idPrefix)) return false;
+    return true;
+}
+
+QVector<int> FlightIndex::query(const FlightQuery& q) const
+{
+    QVector<int> out;
+
+    // Drive the scan from the smallest constrained bucket, check the rest per row.
+    static const QSet<int> kEmpty;
+    const QSet<int>* smallest = nullptr;
+    auto consider = [&](const QSet<int>* s) {
+        if (!s) s = &kEmpty;
+        if (!smallest || s->size() < smallest->size())
+            smallest = s;
+    };
+
+    auto bucket = [](const auto& hash, const auto& key) -> const QSet<int>* {
+        auto it = hash.constFind(key);
+        return it == hash.cend() ? nullptr : &it.value();
+    };
+
+    if (q.srcAirportId >= 0)     consider(bucket(m_bySrc, quint8(q.srcAirportId)));
+    if (q.dstAirportId >= 0)     consider(bucket(m_byDst, quint8(q.dstAirportId)));
+    if (q.typeId >= 0)           consider(bucket(m_byType, quint8(q.typeId)));
+    if (!q.typeClass.isEmpty())  consider(bucket(m_byClass, q.typeClass));
+    if (q.altitudeBand >= 0)     consider(bucket(m_byBand, q.altitudeBand));
+
+    if (smallest) {
+        out.reserve(smallest->size());
+        for (int row : *smallest)
+            if (matches(row, q))
+                out.push_back(row);
+    } else if (!q.idPrefix.isEmpty()) {
+        for (auto it = m_byIdText.lowerBound(q.idPrefix);
+             it != m_byIdText.cend() && it.key().startsWith(q.idPrefix); ++it)
+            out.push_back(it.value());
+    } else {
+        out.reserve(m_keys.size());
+        for (int row = 0; row < m_keys.size(); ++row)
+            out.push_back(row);
+    }
+
+    std::sort(out.begin(), out.end());
+    return out;
+}
@@ -0,0 +1,65 @@
+#ifndef FLIGHTINDEX_H
+#define FLIGHTINDEX_H
+
+#pragma once
+#include <QHash>
+#include <QMap>
+#include <QSet>
+#include <QString>
+#include <QVector>
+#include "Types.h"
+
+struct FlightQuery {
+    int     srcAirportId = -1;     // -1 = any
+    int     dstAirportId = -1;
+    int     typeId = -1;
+    QString typeClass;             // aircraftCatalog() type, empty = any
+    int     altitudeBand = -1;
+    QString idPrefix;              // decimal flightId prefix, empty = any
+
+    bool isEmpty() const
+    {
+        return srcAirportId < 0 && dstAirportId < 0 && typeId < 0 &&
+               typeClass.isEmpty() && altitudeBand < 0 && idPrefix.isEmpty();
+    }
+};
+
+// Secondary indexes over FlightModel rows. Maintained incrementally by
+// FlightModel::upsertFlight; an update only touches the buckets whose key
+// actually changed.
+class FlightIndex {
+public:
+    static constexpr int kBandFt = 10000;
+    static constexpr int kBandCount = 6;
+
+    struct Keys {
+        quint8 src = 0;
+        quint8 dst = 0;
+        quint8 type = 0;
+        int    band = 0;
+    };
+
+    static int  altitudeBand(quint32 altitudeFt) { return int(qMin<quint32>(altitudeFt, kBandFt * kBandCount - 1) / kBandFt); }
+    static Keys keysOf(const FlightRecord& rec) { return { rec.srcAirportId, rec.dstAirportId, rec.typeId, altitudeBand(rec.altitude) }; }
+
+    void clear();
+    void insert(int row, quint32 flightId, const Keys& k);
+    // Returns true if the row moved between buckets.
+    bool update(int row, const Keys& now);
+
+    bool matches(int row, const FlightQuery& q) const;
+    QVector<int> query(const FlightQuery& q) const;   // ascending rows
+
+private:
+    QHash<quint8, QSet<int>>  m_bySrc;
+    QHash<quint8, QSet<int>>  m_byDst;
+    QHash<quint8, QSet<int>>  m_byType;
+    QHash<QString, QSet<int>> m_byClass;
+    QHash<int, QSet<int>>     m_byBand;
+    QMap<QString, int>        m_byIdText;
+
+    QVector<Keys>    m_keys;
+    QVector<quint32> m_ids;
+};
+
+#endif // FLIGHTINDEX_H
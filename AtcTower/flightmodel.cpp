@@ -1,4 +1,44 @@
 #include "flightmodel.h"
+#include <QtMath>
+
+namespace {
+constexpr double kMetersPerDegLat = 111320.0;
+
+// Filter gains: position follows the fix closely, velocity moves a quarter
+// of the way towards each observed residual rate.
+constexpr double kAlpha = 0.6;
+constexpr double kBeta  = 0.25;
+
+constexpr double kMinDtSec       = 0.05;   // closer fixes only replace the raw record; the filter state is kept
+constexpr double kMaxGapSec      = 30.0;   // longer silences restart the filter
+constexpr double kMinTrackSpeed  = 1.0;    // m/s; slower tracks keep their last heading
+
+constexpr double kTeleportTimeSec = 2.0;
+constexpr double kTeleportDistM   = 80000.0;
+
+// North/east offset in metres of (lat, lon) from (lat0, lon0), flat earth.
+void toLocal(double lat0, double lon0, double lat, double lon, double& north, double& east)
+{
+    double dLon = lon - lon0;
+    if (dLon > 180.0)       dLon -= 360.0;
+    else if (dLon < -180.0) dLon += 360.0;
+
+    north = (lat - lat0) * kMetersPerDegLat;
+    east  = dLon * kMetersPerDegLat * std::cos(qDegreesToRadians(lat0));
+}
+
+void restartKinematics(FlightModel::Item& it, const FlightRecord& rec, qint64 nowMs)
+{
+    it.estLat    = rec.latitude();
+    it.estLon    = rec.longitude();
+    it.vNorth    = 0.0;
+    it.vEast     = 0.0;
+    it.climbRate = 0.0;
+    it.fixMs     = nowMs;
+    it.fixAlt    = rec.altitude;
+    it.fixes     = 1;
+}
+}
 
 
 FlightModel::FlightModel(QObject* parent) : QAbstractListModel(parent) {}
@@ -27,6 +67,22 @@ QVariant FlightModel::data(const QModelIndex& idx, int role) const {
         return it.rec.dstAirportId;
     case ArrivedRole:
         return it.arrived;
+    case FlightIdRole:
+        return it.rec.flightId;
+    case VelocityNorthRole:
+        return it.vNorth;
+    case VelocityEastRole:
+        return it.vEast;
+    case FixTimeRole:
+        return double(it.fixMs);
+    case GroundSpeedRole:
+        return it.groundSpeed();
+    case ClimbRateRole:
+        return it.climbRate;
+    case FilteredLatitudeRole:
+        return it.estLat;
+    case FilteredLongitudeRole:
+        return it.estLon;
 
     default:
         return {};
@@ -40,6 +96,14 @@ QHash<int, QByteArray> FlightModel::roleNames() const {
             {HeadingRole, "heading"},
             {DstAirportIdRole, "dstAirportId" },
             {ArrivedRole, "arrived" },
+            {FlightIdRole, "flightId" },
+            {VelocityNorthRole, "vNorth" },
+            {VelocityEastRole, "vEast" },
+            {FixTimeRole, "fixTime" },
+            {GroundSpeedRole, "groundSpeed" },
+            {ClimbRateRole, "climbRate" },
+            {FilteredLatitudeRole, "filteredLatitude" },
+            {FilteredLongitudeRole, "filteredLongitude" },
         };
 }
 
@@ -51,49 +115,84 @@ void FlightModel::upsertFlight(const FlightRecord& rec)
         int   row = *p;
         Item &it  = m_items[row];
 
-        const double oldLat = it.rec.latitude();
-        const double oldLon = it.rec.longitude();
-        const double newLat = rec.latitude();
-        const double newLon = rec.longitude();
-
+        const qint64 nowMs = QDateTime::currentMSecsSinceEpoch();
+        const double dt = (nowMs - it.fixMs) / 1000.0;
 
-        const QDateTime now = QDateTime::currentDateTimeUtc();
-        const double dt = it.lastSeen.isValid() ? it.lastSeen.msecsTo(now) / 1000.0 : 0.0;
-
-        if (dt > 0.0) {
-            QGeoCoordinate c1(oldLat, oldLon);
-            QGeoCoordinate c2(newLat, newLon);
-            const double dist = c1.distanceTo(c2);
-
-            constexpr double kTeleportTimeSec = 2.0;
-            constexpr double kTeleportDistM   = 80000.0;
+        if (it.fixes == 0 || dt > kMaxGapSec) {
+            restartKinematics(it, rec, nowMs);
+        }
+        else if (dt > 0.0) {
+            // Residual of the fix against the predicted position; only the part
+            // the current velocity cannot explain counts towards a teleport.
+            const double predN = it.vNorth * dt;
+            const double predE = it.vEast * dt;
+            double measN, measE;
+            toLocal(it.estLat, it.estLon, rec.latitude(), rec.longitude(), measN, measE);
+            const double resN = measN - predN;
+            const double resE = measE - predE;
+            const double residual = std::hypot(resN, resE);
+
+            if (residual >= kTeleportDistM) {
+                // The window runs from the last receipt, dropped fixes included,
+                // so a repeated jump keeps being rejected.
+                const QDateTime now = QDateTime::currentDateTimeUtc();
+                const double sinceSeen = it.lastSeen.isValid() ? it.lastSeen.msecsTo(now) / 1000.0 : kMaxGapSec;
+
+                if (sinceSeen <= kTeleportTimeSec) {
+                    qWarning().noquote()
+                    << "[sanity] dropped teleport id" << rec.flightId
+                    << "dt" << sinceSeen << "residual" << residual
+                    << "latF" << rec.latitudeFactor << "lonF" << rec.longitudeFactor;
+
+                    it.lastSeen = now;
+                    return;
+                }
 
-            if (dt <= kTeleportTimeSec && dist >= kTeleportDistM) {
-                qWarning().noquote()
-                << "[sanity] dropped teleport id" << rec.flightId
-                << "dt" << dt << "dist" << dist
-                << "latF" << rec.latitudeFactor << "lonF" << rec.longitudeFactor;
+                // Too far off to filter after a longer silence: start over here.
+                restartKinematics(it, rec, nowMs);
+            }
+            else if (dt >= kMinDtSec) {
+                const double climb = (double(rec.altitude) - double(it.fixAlt)) / dt;
+                double offN, offE;
+
+                if (it.fixes == 1) {
+                    // Second fix: seed the velocity from the displacement.
+                    it.vNorth    = measN / dt;
+                    it.vEast     = measE / dt;
+                    it.climbRate = climb;
+                    it.fixes     = 2;
+                    offN = measN;
+                    offE = measE;
+                }
+                else {
+                    it.vNorth    += kBeta * resN / dt;
+                    it.vEast     += kBeta * resE / dt;
+                    it.climbRate += kBeta * (climb - it.climbRate);
+                    offN = predN + kAlpha * resN;
+                    offE = predE + kAlpha * resE;
+                }
 
-                it.lastSeen = QDateTime::currentDateTimeUtc();
-                return;
+                it.estLon += offE / (kMetersPerDegLat * std::cos(qDegreesToRadians(it.estLat)));
+                it.estLat += offN / kMetersPerDegLat;
+                if (it.estLon > 180.0)       it.estLon -= 360.0;
+                else if (it.estLon < -180.0) it.estLon += 360.0;
+                it.fixMs  = nowMs;
+                it.fixAlt = rec.altitude;
+
+                if (it.groundSpeed() >= kMinTrackSpeed) {
+                    double track = qRadiansToDegrees(std::atan2(it.vEast, it.vNorth));
+                    if (track < 0.0)
+                        track += 360.0;
+                    it.headingDeg = track;
+                }
             }
         }
 
+        const RouteState before = routeOf(it);
 
-
-
-        if (!qFuzzyCompare(oldLat, newLat) || !qFuzzyCompare(oldLon, newLon)) {
-            QGeoCoordinate c1(oldLat, oldLon);
-            QGeoCoordinate c2(newLat, newLon);
-
-            double az = c1.azimuthTo(c2);
-
-            if (!qIsNaN(az)) {
-                if (az < 0.0)
-                    az += 360.0;
-                it.headingDeg = az;
-            }
-        }
+        // A new destination means the flight has not arrived there yet.
+        if (rec.dstAirportId != it.rec.dstAirportId)
+            it.arrived = false;
 
         it.rec      = rec;
         it.lastSeen = QDateTime::currentDateTimeUtc();
@@ -118,9 +217,23 @@ void FlightModel::upsertFlight(const FlightRecord& rec)
             HeadingRole,
             DstAirportIdRole,
             ArrivedRole,
+            VelocityNorthRole,
+            VelocityEastRole,
+            FixTimeRole,
+            GroundSpeedRole,
+            ClimbRateRole,
+            FilteredLatitudeRole,
+            FilteredLongitudeRole,
         };
         emit dataChanged(index(row,0), index(row,0), roles);
 
+        if (m_index.update(row, FlightIndex::keysOf(rec)))
+            emit indexKeysChanged(row);
+
+        const RouteState after = routeOf(it);
+        if (after != before)
+            emit routeChanged(row, before, after);
+
     }
     else {
         Item item;
@@ -139,41 +252,36 @@ void FlightModel::upsertFlight(const FlightRecord& rec)
 
         item.lastSeen   = QDateTime::currentDateTimeUtc();
         item.headingDeg = 0.0;
+        restartKinematics(item, rec, item.lastSeen.toMSecsSinceEpoch());
 
         beginInsertRows(QModelIndex(), m_items.size(), m_items.size());
         m_items.push_back(item);
         m_indexById.insert(rec.flightId, m_items.size()-1);
+        m_index.insert(m_items.size()-1, rec.flightId, FlightIndex::keysOf(rec));
         endInsertRows();
+
+        emit routeChanged(m_items.size()-1, RouteState{}, routeOf(item));
     }
 }
 
-
-QVariantMap FlightModel::get(int row) const
+void FlightModel::restore(const QVector<Item>& items)
 {
-    QVariantMap m;
-    if (row < 0 || row >= m_items.size())
-        return m;
-
-    const Item& it = m_items[row];
-    const auto& ac = aircraftCatalog().value(it.rec.typeId);
-
-    const auto& srcInfo = airportCatalog().value(it.rec.srcAirportId);
-    const auto& dstInfo = airportCatalog().value(it.rec.dstAirportId);
-
-
-    m.insert("flightId",   QVariant::fromValue<quint32>(it.rec.flightId));
-    m.insert("typeId",     it.rec.typeId);
-    m.insert("typeName",   ac.name);
-    m.insert("typeClass",  ac.type);
-    m.insert("capacity",   ac.capacity);
-    m.insert("rangeNm",    ac.rangeNm);
-    m.insert("srcAirport", srcInfo.name);
-    m.insert("dstAirport", dstInfo.name);
-    m.insert("srcCountry", srcInfo.country);
-    m.insert("dstCountry", dstInfo.country);
-    m.insert("latitude",   it.rec.latitude());
-    m.insert("longitude",  it.rec.longitude());
-    m.insert("altitude",   QVariant::fromValue<quint32>(it.rec.altitude));
-    m.insert("lastSeen",   it.lastSeen.toString(Qt::ISODate));
-    return m;
+    beginResetModel();
+    m_items = items;
+    m_indexById.clear();
+    m_index.clear();
+    for (int row = 0; row < m_items.size(); ++row) {
+        Item& it = m_items[row];
+        const FlightRecord& rec = it.rec;
+        if (it.fixes == 0) {
+            // Stand still at the restored position until the next fix restarts the filter.
+            it.estLat = rec.latitude();
+            it.estLon = rec.longitude();
+            it.fixMs  = it.lastSeen.toMSecsSinceEpoch();
+            it.fixAlt = rec.altitude;
+        }
+        m_indexById.insert(rec.flightId, row);
+        m_index.insert(row, rec.flightId, FlightIndex::keysOf(rec));
+    }
+    endResetModel();
 }
@@ -5,9 +5,10 @@
 #include <QAbstractListModel>
 #include <QVector>
 #include <QDateTime>
-#include <QVariantMap>
 #include <QGeoCoordinate>
+#include <cmath>
 #include "Types.h"
+#include "flightindex.h"
 
 class FlightModel : public QAbstractListModel {
     Q_OBJECT
@@ -18,29 +19,81 @@ public:
         HeadingRole,
         DstAirportIdRole,
         ArrivedRole,
+        FlightIdRole,
+        VelocityNorthRole,
+        VelocityEastRole,
+        FixTimeRole,
+        GroundSpeedRole,
+        ClimbRateRole,
+        FilteredLatitudeRole,
+        FilteredLongitudeRole,
     };
 
+    struct Item {
+        FlightRecord rec;
+        QDateTime lastSeen;
+        double headingDeg = 0.0;
+        bool arrived = false;
+
+        // Alpha-beta filtered kinematics; the map dead-reckons from
+        // estLat/estLon at fixMs with vNorth/vEast between frames.
+        double estLat = 0.0;        // filtered position at fixMs
+        double estLon = 0.0;
+        double vNorth = 0.0;        // m/s
+        double vEast  = 0.0;        // m/s
+        double climbRate = 0.0;     // ft/s
+        qint64 fixMs  = 0;          // receive time of the last accepted fix, ms since epoch
+        quint32 fixAlt = 0;         // altitude at fixMs
+        int    fixes  = 0;          // fixes since the filter (re)started, saturates at 2
+
+        double groundSpeed() const { return std::hypot(vNorth, vEast); }
+    };
+
+    // The parts of a track that per-airport aggregates depend on.
+    struct RouteState {
+        quint8 src = 0;
+        quint8 dst = 0;
+        bool   arrived = false;
+        bool   exists = false;
+
+        bool operator==(const RouteState& o) const
+        {
+            return src == o.src && dst == o.dst && arrived == o.arrived && exists == o.exists;
+        }
+        bool operator!=(const RouteState& o) const { return !(*this == o); }
+    };
+
+    static RouteState routeOf(const Item& it) { return { it.rec.srcAirportId, it.rec.dstAirportId, it.arrived, true }; }
+
     explicit FlightModel(QObject* parent=nullptr);
 
     int rowCount(const QModelIndex& parent = QModelIndex()) const override;
     QVariant data(const QModelIndex& index, int role) const override;
     QHash<int, QByteArray> roleNames() const override;
-    QVariantMap get(int row) const;
+
+    const Item* item(int row) const { return (row >= 0 && row < m_items.size()) ? &m_items[row] : nullptr; }
+    int rowOf(quint32 flightId) const { return m_indexById.value(flightId, -1); }
+    const FlightIndex& flightIndex() const { return m_index; }
+    const QVector<Item>& items() const { return m_items; }
+
+    // Replaces the whole track table in one reset (warm restart).
+    void restore(const QVector<Item>& items);
 
 
 public slots:
     void upsertFlight(const FlightRecord& rec);
 
-private:
-    struct Item {
-        FlightRecord rec;
-        QDateTime lastSeen;
-        double headingDeg = 0.0;
-        bool arrived = false;
-    };
+signals:
+    // A row moved between FlightIndex buckets (endpoints, type or altitude band).
+    void indexKeysChanged(int row);
+    // Endpoints or arrival state of a row changed, or the row was inserted
+    // (before.exists == false). Not emitted for restore(); listen to modelReset.
+    void routeChanged(int row, const FlightModel::RouteState& before, const FlightModel::RouteState& after);
 
+private:
     QHash<quint32, int> m_indexById;
     QVector<Item> m_items;
+    FlightIndex m_index;
 };
 
 #endif
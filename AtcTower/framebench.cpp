@@ -0,0 +1,151 @@
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <QtEndian>
+#include <QDebug>
+#include <cstdio>
+#include "framedecoder.h"
+
+// Records/sec of the old per-frame extract + FlightRecord::isValid() path
+// against RadarFrame::consume (the RadarClient loop), fed the same stream in
+// socket-sized chunks. Exits non-zero if the two accept different counts.
+//
+//   framebench [frames] [invalidPercent] [garbledPercent]
+//
+// Invalid frames fail validation; garbled frames have a broken footer and
+// force a resync.
+
+static const QByteArray kHeader("\xA5\xA5\xA5\xA5", 4);
+static constexpr int kChunk = 64 * 1024;
+static constexpr quint16 kFactor = 10000;
+
+static QByteArray makeStream(int frames, int invalidPercent, int garbledPercent)
+{
+    const QList<quint8> types    = aircraftCatalog().keys();
+    const QList<quint8> airports = airportCatalog().keys();
+    QRandomGenerator rng(42);
+
+    QByteArray out(frames * RadarFrame::kFrameSize, '\0');
+    for (int i = 0; i < frames; ++i) {
+        uchar* d = reinterpret_cast<uchar*>(out.data()) + i * RadarFrame::kFrameSize;
+        const bool bad     = int(rng.bounded(100)) < invalidPercent;
+        const bool garbled = int(rng.bounded(100)) < garbledPercent;
+
+        qToLittleEndian<quint32>(RadarFrame::kHeaderWord, d);
+        d[4] = types.at(rng.bounded(types.size()));
+        d[5] = airports.at(rng.bounded(airports.size()));
+        d[6] = airports.at((airports.indexOf(d[5]) + 1 + rng.bounded(airports.size() - 1)) % airports.size());
+        qToLittleEndian<quint32>(250000u + rng.bounded(150000u), d + 7);
+        qToLittleEndian<quint16>(kFactor, d + 11);
+        qToLittleEndian<quint32>(bad ? 999999999u : 450000u + rng.bounded(150000u), d + 13);
+        qToLittleEndian<quint16>(kFactor, d + 17);
+        qToLittleEndian<quint32>(1000u + rng.bounded(40000u), d + 19);
+        qToLittleEndian<quint32>(1u + rng.bounded(5000u), d + 23);
+        qToLittleEndian<quint32>(garbled ? 0x12345678u : RadarFrame::kFooterWord, d + 35);
+    }
+    return out;
+}
+
+// The pre-batch frame decode. Returns false on a bad footer.
+static bool decodeOne(const uchar* d, FlightRecord& out)
+{
+    if (qFromLittleEndian<quint32>(d + 35) != RadarFrame::kFooterWord)
+        return false;
+
+    out.typeId         = d[4];
+    out.srcAirportId   = d[5];
+    out.dstAirportId   = d[6];
+    out.latitudeRaw    = qFromLittleEndian<quint32>(d + 7);
+    out.latitudeFactor = qFromLittleEndian<quint16>(d + 11);
+    out.longitudeRaw   = qFromLittleEndian<quint32>(d + 13);
+    out.longitudeFactor= qFromLittleEndian<quint16>(d + 17);
+    out.altitude       = qFromLittleEndian<quint32>(d + 19);
+    out.flightId       = qFromLittleEndian<quint32>(d + 23);
+    return true;
+}
+
+// The pre-batch RadarClient loop: indexOf / mid / remove per frame. Resyncs
+// the same way as RadarFrame::consume so the accepted counts are comparable.
+static int perFrame(const QByteArray& stream)
+{
+    int accepted = 0;
+    QByteArray buffer;
+    for (int off = 0; off < stream.size(); off += kChunk) {
+        buffer.append(stream.constData() + off, qMin(kChunk, int(stream.size() - off)));
+        while (true) {
+            const int pos = buffer.indexOf(kHeader);
+            if (pos < 0) { buffer.remove(0, qMax(0, int(buffer.size()) - 3)); break; }
+            if (buffer.size() < pos + RadarFrame::kFrameSize) break;
+
+            const QByteArray frame = buffer.mid(pos, RadarFrame::kFrameSize);
+            FlightRecord rec;
+            if (!decodeOne(reinterpret_cast<const uchar*>(frame.constData()), rec)) {
+                buffer.remove(0, pos + 1);
+                continue;
+            }
+            buffer.remove(0, pos + RadarFrame::kFrameSize);
+            if (rec.isValid())
+                ++accepted;
+        }
+    }
+    return accepted;
+}
+
+// The current RadarClient::onReadyRead loop.
+static int batched(const QByteArray& stream)
+{
+    int accepted = 0;
+    QByteArray buffer;
+    FrameBatch batch;
+    QVector<FlightRecord> records;
+    for (int off = 0; off < stream.size(); off += kChunk) {
+        buffer.append(stream.constData() + off, qMin(kChunk, int(stream.size() - off)));
+        accepted += RadarFrame::consume(buffer, batch, records);
+    }
+    return accepted;
+}
+
+template <typename F>
+static int run(const char* name, const QByteArray& stream, F fn)
+{
+    const int frames = stream.size() / RadarFrame::kFrameSize;
+    int accepted = fn(stream);   // warm-up
+
+    QElapsedTimer t;
+    t.start();
+    constexpr int kRounds = 5;
+    for (int r = 0; r < kRounds; ++r)
+        accepted = fn(stream);
+    const double sec = t.nsecsElapsed() / 1e9;
+
+    qInfo().noquote() << QString("%1  %2 Mrec/s  (%3 accepted of %4)")
+                             .arg(QLatin1String(name), -10)
+                             .arg(kRounds * frames / sec / 1e6, 0, 'f', 2)
+                             .arg(accepted).arg(frames);
+    return accepted;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    const QStringList args = app.arguments();
+    const int frames         = args.size() > 1 ? args.at(1).toInt() : 1000000;
+    const int invalidPercent = args.size() > 2 ? args.at(2).toInt() : 1;
+    const int garbledPercent = args.size() > 3 ? args.at(3).toInt() : 0;
+
+    // isValid() logs every rejected record; keep that out of the timing.
+    qInstallMessageHandler([](QtMsgType type, const QMessageLogContext&, const QString& msg){
+        if (type == QtInfoMsg)
+            fprintf(stdout, "%s\n", qPrintable(msg));
+    });
+
+    const QByteArray stream = makeStream(frames, invalidPercent, garbledPercent);
+    qInfo().noquote() << "batch path:" << RadarFrame::simdPath();
+    const int expected = run("per-frame", stream, perFrame);
+    const int actual   = run("batch", stream, batched);
+    if (actual != expected) {
+        fprintf(stderr, "MISMATCH: batch accepted %d, per-frame accepted %d\n", actual, expected);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,406 @@
+#include "framedecoder.h"
+#include <QtEndian>
+#include <QtAlgorithms>
+#include <QDebug>
+#include <cstring>
+#include <utility>
+
+#if defined(__AVX2__) || defined(__SSE4_1__)
+#include <immintrin.h>
+#endif
+
+
+namespace {
+
+constexpr quint32 kMaxAltitudeFt = 60000u;
+constexpr quint32 kMaxLatDeg     = 90u;
+constexpr quint32 kMaxLonDeg     = 180u;
+
+// 0 / -1 per id, int-sized so the AVX2 path can gather from it.
+struct CatalogTables {
+    qint32 type[256] = {};
+    qint32 airport[256] = {};
+};
+
+const CatalogTables& catalogTables()
+{
+    static const CatalogTables t = []{
+        CatalogTables c;
+        for (auto it = aircraftCatalog().cbegin(); it != aircraftCatalog().cend(); ++it)
+            c.type[it.key()] = -1;
+        for (auto it = airportCatalog().cbegin(); it != airportCatalog().cend(); ++it)
+            c.airport[it.key()] = -1;
+        return c;
+    }();
+    return t;
+}
+
+void resize(FrameBatch& b, int n)
+{
+    b.count = n;
+    b.typeId.resize(n);
+    b.srcAirportId.resize(n);
+    b.dstAirportId.resize(n);
+    b.latitudeRaw.resize(n);
+    b.latitudeFactor.resize(n);
+    b.longitudeRaw.resize(n);
+    b.longitudeFactor.resize(n);
+    b.altitude.resize(n);
+    b.flightId.resize(n);
+    b.reject.resize(n);
+    b.validMask.fill(0, (n + 63) / 64);
+}
+
+void extractScalar(const uchar* frames, int from, int to, FrameBatch& b)
+{
+    for (int i = from; i < to; ++i) {
+        const uchar* d = frames + qsizetype(i) * RadarFrame::kFrameSize;
+
+        const quint32 header = qFromLittleEndian<quint32>(d);
+        const quint32 footer = qFromLittleEndian<quint32>(d + 35);
+        b.reject[i] = quint8(header != RadarFrame::kHeaderWord ? FrameReject::BadHeader
+                           : footer != RadarFrame::kFooterWord ? FrameReject::BadFooter
+                                                               : FrameReject::None);
+
+        b.typeId[i]          = d[4];
+        b.srcAirportId[i]    = d[5];
+        b.dstAirportId[i]    = d[6];
+        b.latitudeRaw[i]     = qFromLittleEndian<quint32>(d + 7);
+        b.latitudeFactor[i]  = qFromLittleEndian<quint16>(d + 11);
+        b.longitudeRaw[i]    = qFromLittleEndian<quint32>(d + 13);
+        b.longitudeFactor[i] = qFromLittleEndian<quint16>(d + 17);
+        b.altitude[i]        = qFromLittleEndian<quint32>(d + 19);
+        b.flightId[i]        = qFromLittleEndian<quint32>(d + 23);
+    }
+}
+
+// Reason for a frame whose framing was fine; same order as FlightRecord::isValid().
+FrameReject classify(const FrameBatch& b, int i)
+{
+    const CatalogTables& t = catalogTables();
+
+    if (!b.latitudeFactor[i] || !b.longitudeFactor[i])              return FrameReject::ZeroFactor;
+    if (b.latitudeRaw[i]  > kMaxLatDeg * b.latitudeFactor[i])        return FrameReject::LatitudeRange;
+    if (b.longitudeRaw[i] > kMaxLonDeg * b.longitudeFactor[i])       return FrameReject::LongitudeRange;
+    if (b.altitude[i] > kMaxAltitudeFt)                              return FrameReject::AltitudeRange;
+    if (b.altitude[i] == 0u)                                         return FrameReject::AltitudeZero;
+    if (b.flightId[i] == 0u)                                         return FrameReject::ZeroFlightId;
+    if (!t.type[b.typeId[i]])                                        return FrameReject::UnknownType;
+    if (!t.airport[b.srcAirportId[i]])                               return FrameReject::UnknownSrcAirport;
+    if (!t.airport[b.dstAirportId[i]])                               return FrameReject::UnknownDstAirport;
+    if (b.srcAirportId[i] == b.dstAirportId[i])                      return FrameReject::SameAirport;
+    return FrameReject::None;
+}
+
+void validateScalar(int from, int to, FrameBatch& b)
+{
+    for (int i = from; i < to; ++i) {
+        if (b.reject[i] == quint8(FrameReject::None))
+            b.reject[i] = quint8(classify(b, i));
+        if (b.reject[i] == quint8(FrameReject::None))
+            b.validMask[i >> 6] |= quint64(1) << (i & 63);
+    }
+}
+
+#if defined(__AVX2__) || defined(__SSE4_1__)
+// SIMD lanes that failed only get a reason code, from the scalar classifier.
+void finishLanes(int from, unsigned laneBits, int lanes, FrameBatch& b)
+{
+    b.validMask[from >> 6] |= quint64(laneBits) << (from & 63);
+    for (int k = 0; k < lanes; ++k) {
+        const int i = from + k;
+        if (!((laneBits >> k) & 1u) && b.reject[i] == quint8(FrameReject::None))
+            b.reject[i] = quint8(classify(b, i));
+    }
+}
+#endif
+
+#if defined(__AVX2__)
+
+constexpr int kLanes = 8;
+
+void extractSimd(const uchar* frames, int from, FrameBatch& b)
+{
+    const __m256i idx   = _mm256_setr_epi32(0, 39, 78, 117, 156, 195, 234, 273);
+    const __m256i lo16  = _mm256_set1_epi32(0xFFFF);
+    const uchar*  p     = frames + qsizetype(from) * RadarFrame::kFrameSize;
+
+    auto gather = [&](int off) {
+        return _mm256_i32gather_epi32(reinterpret_cast<const int*>(p + off), idx, 1);
+    };
+
+    const __m256i header = gather(0);
+    const __m256i footer = gather(35);
+    const __m256i ids    = gather(4);
+    const __m256i latF   = _mm256_and_si256(gather(11), lo16);
+    const __m256i lonF   = _mm256_and_si256(gather(17), lo16);
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(b.latitudeRaw.data() + from),  gather(7));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(b.longitudeRaw.data() + from), gather(13));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(b.altitude.data() + from),     gather(19));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(b.flightId.data() + from),     gather(23));
+
+    const unsigned hdrOk = unsigned(_mm256_movemask_ps(_mm256_castsi256_ps(
+        _mm256_cmpeq_epi32(header, _mm256_set1_epi32(int(RadarFrame::kHeaderWord))))));
+    const unsigned ftrOk = unsigned(_mm256_movemask_ps(_mm256_castsi256_ps(
+        _mm256_cmpeq_epi32(footer, _mm256_set1_epi32(int(RadarFrame::kFooterWord))))));
+
+    alignas(32) quint32 idsOut[kLanes], latFOut[kLanes], lonFOut[kLanes];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(idsOut),  ids);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(latFOut), latF);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lonFOut), lonF);
+
+    for (int k = 0; k < kLanes; ++k) {
+        const int i = from + k;
+        b.typeId[i]          = quint8(idsOut[k]);
+        b.srcAirportId[i]    = quint8(idsOut[k] >> 8);
+        b.dstAirportId[i]    = quint8(idsOut[k] >> 16);
+        b.latitudeFactor[i]  = quint16(latFOut[k]);
+        b.longitudeFactor[i] = quint16(lonFOut[k]);
+        b.reject[i] = quint8(!((hdrOk >> k) & 1u) ? FrameReject::BadHeader
+                           : !((ftrOk >> k) & 1u) ? FrameReject::BadFooter
+                                                  : FrameReject::None);
+    }
+}
+
+inline __m256i le(__m256i a, __m256i b)   // unsigned a <= b
+{
+    return _mm256_cmpeq_epi32(_mm256_max_epu32(a, b), b);
+}
+
+unsigned validateSimd(int from, const FrameBatch& b)
+{
+    const CatalogTables& t = catalogTables();
+    const __m256i zero = _mm256_setzero_si256();
+
+    auto u32 = [&](const QVector<quint32>& v) {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(v.constData() + from));
+    };
+    auto u16 = [&](const QVector<quint16>& v) {
+        return _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(v.constData() + from)));
+    };
+    auto u8 = [&](const QVector<quint8>& v) {
+        return _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(v.constData() + from)));
+    };
+
+    const __m256i latR = u32(b.latitudeRaw);
+    const __m256i lonR = u32(b.longitudeRaw);
+    const __m256i alt  = u32(b.altitude);
+    const __m256i fid  = u32(b.flightId);
+    const __m256i latF = u16(b.latitudeFactor);
+    const __m256i lonF = u16(b.longitudeFactor);
+    const __m256i type = u8(b.typeId);
+    const __m256i src  = u8(b.srcAirportId);
+    const __m256i dst  = u8(b.dstAirportId);
+
+    __m256i bad = _mm256_cmpeq_epi32(u8(b.reject), zero);
+    bad = _mm256_xor_si256(bad, _mm256_set1_epi32(-1));
+    bad = _mm256_or_si256(bad, _mm256_cmpeq_epi32(latF, zero));
+    bad = _mm256_or_si256(bad, _mm256_cmpeq_epi32(lonF, zero));
+    bad = _mm256_or_si256(bad, _mm256_cmpeq_epi32(alt, zero));
+    bad = _mm256_or_si256(bad, _mm256_cmpeq_epi32(fid, zero));
+    bad = _mm256_or_si256(bad, _mm256_cmpeq_epi32(src, dst));
+
+    __m256i ok = le(latR, _mm256_mullo_epi32(latF, _mm256_set1_epi32(int(kMaxLatDeg))));
+    ok = _mm256_and_si256(ok, le(lonR, _mm256_mullo_epi32(lonF, _mm256_set1_epi32(int(kMaxLonDeg)))));
+    ok = _mm256_and_si256(ok, le(alt, _mm256_set1_epi32(int(kMaxAltitudeFt))));
+    ok = _mm256_and_si256(ok, _mm256_i32gather_epi32(reinterpret_cast<const int*>(t.type), type, 4));
+    ok = _mm256_and_si256(ok, _mm256_i32gather_epi32(reinterpret_cast<const int*>(t.airport), src, 4));
+    ok = _mm256_and_si256(ok, _mm256_i32gather_epi32(reinterpret_cast<const int*>(t.airport), dst, 4));
+    ok = _mm256_andnot_si256(bad, ok);
+
+    return unsigned(_mm256_movemask_ps(_mm256_castsi256_ps(ok)));
+}
+
+#elif defined(__SSE4_1__)
+
+constexpr int kLanes = 4;
+
+void extractSimd(const uchar* frames, int from, FrameBatch& b)
+{
+    // No gather before AVX2: fields are pulled out per frame.
+    extractScalar(frames, from, from + kLanes, b);
+}
+
+inline __m128i le(__m128i a, __m128i b)   // unsigned a <= b
+{
+    return _mm_cmpeq_epi32(_mm_max_epu32(a, b), b);
+}
+
+unsigned validateSimd(int from, const FrameBatch& b)
+{
+    const CatalogTables& t = catalogTables();
+    const __m128i zero = _mm_setzero_si128();
+
+    auto u32 = [&](const QVector<quint32>& v) {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(v.constData() + from));
+    };
+    auto u16 = [&](const QVector<quint16>& v) {
+        return _mm_cvtepu16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(v.constData() + from)));
+    };
+    auto u8 = [&](const QVector<quint8>& v) {
+        int w;
+        memcpy(&w, v.constData() + from, sizeof w);
+        return _mm_cvtepu8_epi32(_mm_cvtsi32_si128(w));
+    };
+
+    const __m128i latR = u32(b.latitudeRaw);
+    const __m128i lonR = u32(b.longitudeRaw);
+    const __m128i alt  = u32(b.altitude);
+    const __m128i fid  = u32(b.flightId);
+    const __m128i latF = u16(b.latitudeFactor);
+    const __m128i lonF = u16(b.longitudeFactor);
+    const __m128i src  = u8(b.srcAirportId);
+    const __m128i dst  = u8(b.dstAirportId);
+
+    const quint8* ty = b.typeId.constData() + from;
+    const quint8* sa = b.srcAirportId.constData() + from;
+    const quint8* da = b.dstAirportId.constData() + from;
+    const __m128i catalog = _mm_setr_epi32(t.type[ty[0]] & t.airport[sa[0]] & t.airport[da[0]],
+                                           t.type[ty[1]] & t.airport[sa[1]] & t.airport[da[1]],
+                                           t.type[ty[2]] & t.airport[sa[2]] & t.airport[da[2]],
+                                           t.type[ty[3]] & t.airport[sa[3]] & t.airport[da[3]]);
+
+    __m128i bad = _mm_xor_si128(_mm_cmpeq_epi32(u8(b.reject), zero), _mm_set1_epi32(-1));
+    bad = _mm_or_si128(bad, _mm_cmpeq_epi32(latF, zero));
+    bad = _mm_or_si128(bad, _mm_cmpeq_epi32(lonF, zero));
+    bad = _mm_or_si128(bad, _mm_cmpeq_epi32(alt, zero));
+    bad = _mm_or_si128(bad, _mm_cmpeq_epi32(fid, zero));
+    bad = _mm_or_si128(bad, _mm_cmpeq_epi32(src, dst));
+
+    __m128i ok = le(latR, _mm_mullo_epi32(latF, _mm_set1_epi32(int(kMaxLatDeg))));
+    ok = _mm_and_si128(ok, le(lonR, _mm_mullo_epi32(lonF, _mm_set1_epi32(int(kMaxLonDeg)))));
+    ok = _mm_and_si128(ok, le(alt, _mm_set1_epi32(int(kMaxAltitudeFt))));
+    ok = _mm_and_si128(ok, catalog);
+    ok = _mm_andnot_si128(bad, ok);
+
+    return unsigned(_mm_movemask_ps(_mm_castsi128_ps(ok)));
+}
+
+#endif
+
+} // namespace
+
+
+FlightRecord FrameBatch::record(int i) const
+{
+    FlightRecord r;
+    r.typeId          = typeId[i];
+    r.srcAirportId    = srcAirportId[i];
+    r.dstAirportId    = dstAirportId[i];
+    r.latitudeRaw     = latitudeRaw[i];
+    r.latitudeFactor  = latitudeFactor[i];
+    r.longitudeRaw    = longitudeRaw[i];
+    r.longitudeFactor = longitudeFactor[i];
+    r.altitude        = altitude[i];
+    r.flightId        = flightId[i];
+    return r;
+}
+
+int RadarFrame::decodeBatch(const uchar* frames, int count, FrameBatch& out)
+{
+    resize(out, count);
+
+    int i = 0;
+#if defined(__AVX2__) || defined(__SSE4_1__)
+    for (; i + kLanes <= count; i += kLanes) {
+        extractSimd(frames, i, out);
+        finishLanes(i, validateSimd(i, out), kLanes, out);
+    }
+#endif
+    extractScalar(frames, i, count, out);
+    validateScalar(i, count, out);
+
+    int valid = 0;
+    for (quint64 w : std::as_const(out.validMask))
+        valid += qPopulationCount(w);
+    return valid;
+}
+
+int RadarFrame::consume(QByteArray& buffer, FrameBatch& batch, QVector<FlightRecord>& accepted)
+{
+    static const QByteArray kHeader("\xA5\xA5\xA5\xA5", 4);
+    accepted.clear();
+
+    while (true) {
+        const int pos = buffer.indexOf(kHeader);
+        if (pos < 0) {
+            // Keep a header that may be split across reads.
+            buffer.remove(0, qMax(0, int(buffer.size()) - int(kHeader.size() - 1)));
+            break;
+        }
+
+        const int n = (buffer.size() - pos) / kFrameSize;
+        if (n == 0) break;
+
+        // Frames up to the first bad header or footer; anything past it is
+        // re-scanned after the resync instead of being decoded twice.
+        const uchar* d = reinterpret_cast<const uchar*>(buffer.constData()) + pos;
+        int run = 0;
+        while (run < n
+               && qFromLittleEndian<quint32>(d + run * kFrameSize) == kHeaderWord
+               && qFromLittleEndian<quint32>(d + run * kFrameSize + kFrameSize - 4) == kFooterWord)
+            ++run;
+
+        if (run > 0) {
+            decodeBatch(d, run, batch);
+            for (int i = 0; i < run; ++i) {
+                const FlightRecord rec = batch.record(i);
+                if (batch.isValid(i)) {
+                    accepted.push_back(rec);
+                    continue;
+                }
+                qWarning() << "[radar] dropped invalid record" << rec.flightId
+                           << "-" << rejectName(batch.rejectOf(i))
+                           << "type" << rec.typeId
+                           << "src" << rec.srcAirportId
+                           << "dst" << rec.dstAirportId
+                           << "lat" << rec.latitude()
+                           << "lon" << rec.longitude()
+                           << "alt" << rec.altitude;
+            }
+        }
+
+        if (run == n) {
+            buffer.remove(0, pos + n * kFrameSize);
+            break;
+        }
+
+        // Lost alignment at frame `run`: resync on the next header, skipping
+        // one byte past a header whose footer did not match.
+        const int skip = (qFromLittleEndian<quint32>(d + run * kFrameSize) == kHeaderWord) ? 1 : 0;
+        buffer.remove(0, pos + run * kFrameSize + skip);
+    }
+    return accepted.size();
+}
+
+const char* RadarFrame::rejectName(FrameReject r)
+{
+    switch (r) {
+    case FrameReject::None:              return "ok";
+    case FrameReject::BadHeader:         return "bad header";
+    case FrameReject::BadFooter:         return "bad footer";
+    case FrameReject::ZeroFactor:        return "zero lat/lon factor";
+    case FrameReject::LatitudeRange:     return "latitude out of range";
+    case FrameReject::LongitudeRange:    return "longitude out of range";
+    case FrameReject::AltitudeRange:     return "altitude out of range";
+    case FrameReject::AltitudeZero:      return "altitude = 0";
+    case FrameReject::ZeroFlightId:      return "flightId = 0";
+    case FrameReject::UnknownType:       return "unknown typeId";
+    case FrameReject::UnknownSrcAirport: return "unknown srcAirportId";
+    case FrameReject::UnknownDstAirport: return "unknown dstAirportId";
+    case FrameReject::SameAirport:       return "srcAirportId == dstAirportId";
+    }
+    return "?";
+}
+
+const char* RadarFrame::simdPath()
+{
+#if defined(__AVX2__)
+    return "AVX2";
+#elif defined(__SSE4_1__)
+    return "SSE4.1";
+#else
+    return "scalar";
+#endif
+}
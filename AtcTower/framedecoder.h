@@ -0,0 +1,68 @@
+#ifndef FRAMEDECODER_H
+#define FRAMEDECODER_H
+
+#pragma once
+#include <QVector>
+#include <QByteArray>
+#include "Types.h"
+
+// Why a frame was rejected; checks run in this order, same as FlightRecord::isValid().
+enum class FrameReject : quint8 {
+    None = 0,
+    BadHeader,
+    BadFooter,
+    ZeroFactor,
+    LatitudeRange,
+    LongitudeRange,
+    AltitudeRange,
+    AltitudeZero,
+    ZeroFlightId,
+    UnknownType,
+    UnknownSrcAirport,
+    UnknownDstAirport,
+    SameAirport,
+};
+
+// Columnar decode of a run of frames plus a validity bitmask.
+struct FrameBatch {
+    int count = 0;
+
+    QVector<quint8>  typeId;
+    QVector<quint8>  srcAirportId;
+    QVector<quint8>  dstAirportId;
+    QVector<quint32> latitudeRaw;
+    QVector<quint16> latitudeFactor;
+    QVector<quint32> longitudeRaw;
+    QVector<quint16> longitudeFactor;
+    QVector<quint32> altitude;
+    QVector<quint32> flightId;
+
+    QVector<quint64> validMask;   // bit i%64 of word i/64
+    QVector<quint8>  reject;      // FrameReject per frame
+
+    bool isValid(int i) const { return (validMask[i >> 6] >> (i & 63)) & 1u; }
+    FrameReject rejectOf(int i) const { return FrameReject(reject[i]); }
+    FlightRecord record(int i) const;
+};
+
+namespace RadarFrame {
+static constexpr int     kFrameSize  = 39;
+static constexpr quint32 kHeaderWord = 0xA5A5A5A5u;
+static constexpr quint32 kFooterWord = 0x55555555u;
+
+// Decodes and validates `count` back-to-back frames starting at `frames`.
+// Uses AVX2 or SSE4.1 when the build enables them, scalar otherwise.
+// Returns the number of valid frames.
+int decodeBatch(const uchar* frames, int count, FrameBatch& out);
+
+// Decodes every complete frame in `buffer` and removes the consumed bytes.
+// Only the aligned run up to the next framing error is batch-decoded, then
+// the stream resyncs on the next header. Valid records replace the contents
+// of `accepted`; invalid ones are logged. Returns the number accepted.
+int consume(QByteArray& buffer, FrameBatch& batch, QVector<FlightRecord>& accepted);
+
+const char* rejectName(FrameReject r);
+const char* simdPath();
+}
+
+#endif // FRAMEDECODER_H
@@ -1,8 +1,12 @@
 #include <QApplication>
 #include "flightmodel.h"
 #include "radarclient.h"
+#include "tileserver.h"
+#include "trackstore.h"
+#include "trackpublisher.h"
 #include "mainwindow.h"
 #include <QtCore/QResource>
+#include <QStandardPaths>
 
 
 
@@ -14,11 +18,26 @@ int main(int argc, char *argv[])
 
     FlightModel  model;
     RadarClient  radar;
+    TileServer   tiles;
 
     QObject::connect(&radar, &RadarClient::flightReceived,
                      &model, &FlightModel::upsertFlight);
 
-    MainWindow w(&model, &radar);
+    TrackPublisher publisher(&model);
+
+    TrackStore store(&model, QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/tracks.snap");
+    store.load();
+    store.setPublisher(&publisher);
+    publisher.start(250);
+    store.start(5000);
+    QObject::connect(&app, &QCoreApplication::aboutToQuit, &store, &TrackStore::saveNow);
+
+    const QString tilePack = qEnvironmentVariable("ATC_TILEPACK",
+                                                  QCoreApplication::applicationDirPath() + "/basemap.tilepack");
+    if (QFile::exists(tilePack))
+        tiles.start(tilePack);
+
+    MainWindow w(&model, &radar, &tiles);
     w.resize(1350, 720);
     w.show();
 
@@ -1,5 +1,9 @@
 #include "MainWindow.h"
 #include <QListView>
+#include <QTableView>
+#include <QHeaderView>
+#include <QComboBox>
+#include <QGridLayout>
 #include <QLabel>
 #include <QLineEdit>
 #include <QPushButton>
@@ -11,40 +15,91 @@
 #include <QQuickItem>
 #include <QMessageBox>
 #include "flightmodel.h"
+#include "flightfiltermodel.h"
+#include "airporttrafficmodel.h"
 #include "radarclient.h"
+#include "tileserver.h"
+#include "selectedflight.h"
 
-MainWindow::MainWindow(FlightModel* model, RadarClient* radar, QWidget* parent)
-    : QMainWindow(parent), m_model(model), m_radar(radar)
+MainWindow::MainWindow(FlightModel* model, RadarClient* radar, TileServer* tiles, QWidget* parent)
+    : QMainWindow(parent), m_model(model), m_radar(radar), m_tiles(tiles)
 {
     auto *central = new QWidget;
     setCentralWidget(central);
 
+    m_filter = new FlightFilterModel(m_model, this);
+    m_traffic = new AirportTrafficModel(m_model, this);
+
     m_list = new QListView;
-    m_list->setModel(m_model);
+    m_list->setModel(m_filter);
     m_list->setSelectionMode(QAbstractItemView::SingleSelection);
     m_list->setMinimumWidth(200);
 
 
     connect(m_list->selectionModel(), &QItemSelectionModel::currentChanged,this, &MainWindow::onRowChanged);
 
-    connect(m_model, &QAbstractItemModel::dataChanged,
-            this,
-            [this](
-                const QModelIndex& topLeft,
-                const QModelIndex& bottomRight,
-                const QVector<int>& /*roles*/)
-            {
-                const int row = m_list->currentIndex().row();
-
-                if (row < 0)
-                    return;
-
-                if (topLeft.row() <= row && row <= bottomRight.row())
-                    updateDetails(row);
-
-            });
-
+    m_selected = new SelectedFlight(m_model, this);
+
+    // Selection made on the map, or rows shuffled by the filter: mirror the
+    // selected flight in the list without recentering.
+    connect(m_selected, &SelectedFlight::rowChanged, this, &MainWindow::syncListToSelection);
+    connect(m_filter, &QAbstractItemModel::rowsRemoved,  this, &MainWindow::syncListToSelection);
+    connect(m_filter, &QAbstractItemModel::rowsInserted, this, &MainWindow::syncListToSelection);
+    connect(m_filter, &QAbstractItemModel::modelReset,   this, &MainWindow::syncListToSelection);
+
+    // Keep the tile cache warm around the selected flight, wherever it was picked.
+    connect(m_selected, &SelectedFlight::flightIdChanged, this, [this]{ prefetchSelected(true); });
+    connect(m_selected, &SelectedFlight::positionChanged, this, [this]{ prefetchSelected(false); });
+
+
+    m_search = new QLineEdit;
+    m_search->setPlaceholderText("Flight ID prefix");
+    m_search->setClearButtonEnabled(true);
+
+    m_cmbFrom  = new QComboBox;
+    m_cmbTo    = new QComboBox;
+    m_cmbClass = new QComboBox;
+    m_cmbAlt   = new QComboBox;
+
+    m_cmbFrom->addItem("Any origin", -1);
+    m_cmbTo->addItem("Any destination", -1);
+    QMap<QString, int> airportsByName;
+    for (auto it = airportCatalog().cbegin(); it != airportCatalog().cend(); ++it)
+        airportsByName.insert(it.value().name, it.key());
+    for (auto it = airportsByName.cbegin(); it != airportsByName.cend(); ++it) {
+        m_cmbFrom->addItem(it.key(), it.value());
+        m_cmbTo->addItem(it.key(), it.value());
+    }
 
+    m_cmbClass->addItem("Any class", QString());
+    QSet<QString> classes;
+    for (const auto& ac : aircraftCatalog())
+        classes.insert(ac.type);
+    QStringList classList(classes.cbegin(), classes.cend());
+    classList.sort();
+    for (const QString& c : classList)
+        m_cmbClass->addItem(c, c);
+
+    m_cmbAlt->addItem("Any altitude", -1);
+    for (int b = 0; b < FlightIndex::kBandCount; ++b)
+        m_cmbAlt->addItem(QString("%1k - %2k ft").arg(b * FlightIndex::kBandFt / 1000)
+                                                 .arg((b + 1) * FlightIndex::kBandFt / 1000), b);
+
+    connect(m_search, &QLineEdit::textChanged, this, &MainWindow::onFilterChanged);
+    for (QComboBox *c : {m_cmbFrom, m_cmbTo, m_cmbClass, m_cmbAlt})
+        connect(c, &QComboBox::currentIndexChanged, this, &MainWindow::onFilterChanged);
+
+    QWidget *left = new QWidget;
+    auto *lv = new QVBoxLayout(left);
+    lv->setContentsMargins(0, 0, 0, 0);
+    auto *filters = new QGridLayout;
+    filters->addWidget(m_cmbFrom,  0, 0);
+    filters->addWidget(m_cmbTo,    0, 1);
+    filters->addWidget(m_cmbClass, 1, 0);
+    filters->addWidget(m_cmbAlt,   1, 1);
+    lv->addWidget(m_search);
+    lv->addLayout(filters);
+    lv->addWidget(m_list, 1);
 
 
 
@@ -64,8 +119,15 @@ MainWindow::MainWindow(FlightModel* model, RadarClient* radar, QWidget* parent)
         airportList.push_back(a);
     }
 
-    m_map->rootContext()->setContextProperty("flightModel", m_model);
+    m_map->rootContext()->setContextProperty("flightFilter", m_filter);
+    m_map->rootContext()->setContextProperty("airportTraffic", m_traffic);
     m_map->rootContext()->setContextProperty("airportList", airportList);
+    m_map->rootContext()->setContextProperty("selectedFlight", m_selected);
+
+    const QString tileHost = (m_tiles && m_tiles->isServing())
+                                 ? m_tiles->hostUrl()
+                                 : QStringLiteral("https://a.basemaps.cartocdn.com/dark_all");
+    m_map->rootContext()->setContextProperty("tileHost", tileHost);
 
     m_map->setSource(QUrl(QStringLiteral("qrc:/map.qml")));
     m_map->setMinimumWidth(700);
@@ -93,12 +155,22 @@ MainWindow::MainWindow(FlightModel* model, RadarClient* radar, QWidget* parent)
     rv->addWidget(mkRow("Lat/Lon:",   m_lblLatLon));
     rv->addWidget(mkRow("Altitude:",  m_lblAlt));
     rv->addWidget(mkRow("Last seen:", m_lblSeen));
-    rv->addStretch();
+
+    m_board = new QTableView;
+    m_board->setModel(m_traffic);
+    m_board->setSelectionMode(QAbstractItemView::NoSelection);
+    m_board->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    m_board->verticalHeader()->hide();
+    m_board->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
+    m_board->horizontalHeader()->setStretchLastSection(true);
+    rv->addWidget(new QLabel("<b>Arrival board</b>"));
+    rv->addWidget(m_board, 1);
+    bindDetails();
 
 
     auto *split = new QSplitter;
 
-    split->addWidget(m_list);
+    split->addWidget(left);
     split->addWidget(m_map);
     split->addWidget(right);
     split->setSizes({250, 800, 300});
@@ -174,39 +246,67 @@ MainWindow::MainWindow(FlightModel* model, RadarClient* radar, QWidget* parent)
 
 void MainWindow::onRowChanged(const QModelIndex& current)
 {
-    const int row = current.row();
-    updateDetails(row);
+    if (m_syncingList || m_filter->isRemapping())
+        return;
 
-    QVariantMap rec = m_model->get(row);
-    if (!rec.isEmpty()) {
-        centerMap(rec.value("latitude").toDouble(),
-                  rec.value("longitude").toDouble());
-    }
+    const int row = m_filter->mapToSource(current).row();
+    if (row == m_selected->row())
+        return;
+
+    m_selected->selectRow(row);
+    if (m_selected->isValid())
+        centerMap(m_selected->latitude(), m_selected->longitude());
 }
 
-void MainWindow::updateDetails(int row)
+void MainWindow::bindDetails()
 {
-    if (m_map && m_map->rootObject()) {
-        m_map->rootObject()->setProperty("currentIndex", row);
-    }
+    auto orDash = [this](const QString& s) { return m_selected->isValid() ? s : QStringLiteral("-"); };
+
+    auto setId = [=]{ m_lblId->setText(orDash(QString::number(m_selected->flightId()))); };
+    auto setType = [=]{
+        m_lblType->setText(orDash(m_selected->typeName()));
+        m_lblClass->setText(orDash(m_selected->typeClass()));
+    };
+    auto setFrom = [=]{ m_lblFrom->setText(orDash(m_selected->srcAirport() + "  -  " + m_selected->srcCountry())); };
+    auto setTo   = [=]{ m_lblTo->setText(orDash(m_selected->dstAirport() + "  -  " + m_selected->dstCountry())); };
+    auto setPos  = [=]{
+        m_lblLatLon->setText(orDash(QString::number(m_selected->latitude(), 'f', 4) + " , " +
+                                    QString::number(m_selected->longitude(), 'f', 4)));
+    };
+    auto setAlt  = [=]{ m_lblAlt->setText(orDash(QString::number(m_selected->altitude()))); };
+    auto setSeen = [=]{ m_lblSeen->setText(orDash(m_selected->lastSeen().toString(Qt::ISODate))); };
 
-    QVariantMap rec = m_model->get(row);
-    if (rec.isEmpty()) {
-        m_lblId->setText("-"); m_lblType->setText("-"); m_lblClass->setText("-");
-        m_lblFrom->setText("-"); m_lblTo->setText("-"); m_lblLatLon->setText("-");
-        m_lblAlt->setText("-"); m_lblSeen->setText("-");
+    connect(m_selected, &SelectedFlight::rowChanged, this, [=]{
+        setId(); setType(); setFrom(); setTo(); setPos(); setAlt(); setSeen();
+    });
+    connect(m_selected, &SelectedFlight::typeChanged,       this, setType);
+    connect(m_selected, &SelectedFlight::srcAirportChanged, this, setFrom);
+    connect(m_selected, &SelectedFlight::dstAirportChanged, this, setTo);
+    connect(m_selected, &SelectedFlight::positionChanged,   this, setPos);
+    connect(m_selected, &SelectedFlight::altitudeChanged,   this, setAlt);
+    connect(m_selected, &SelectedFlight::lastSeenChanged,   this, setSeen);
+}
+
+void MainWindow::syncListToSelection()
+{
+    const QModelIndex want = m_filter->mapFromSource(m_model->index(m_selected->row(), 0));
+    if (m_list->currentIndex() == want)
         return;
-    }
-    m_lblId->setText(QString::number(rec.value("flightId").toUInt()));
-    m_lblType->setText(rec.value("typeName").toString());
-    m_lblClass->setText(rec.value("typeClass").toString());
-    m_lblFrom->setText(rec.value("srcAirport").toString() + "  -  " + rec.value("srcCountry").toString()) ;
-    m_lblTo->setText(rec.value("dstAirport").toString() +  "  -  " + rec.value("dstCountry").toString());
-    const double lat = rec.value("latitude").toDouble();
-    const double lon = rec.value("longitude").toDouble();
-    m_lblLatLon->setText(QString::number(lat, 'f', 4) + " , " + QString::number(lon, 'f', 4));
-    m_lblAlt->setText(QString::number(rec.value("altitude").toUInt()));
-    m_lblSeen->setText(rec.value("lastSeen").toString());
+
+    m_syncingList = true;
+    m_list->setCurrentIndex(want);
+    m_syncingList = false;
+}
+
+void MainWindow::onFilterChanged()
+{
+    FlightQuery q;
+    q.srcAirportId = m_cmbFrom->currentData().toInt();
+    q.dstAirportId = m_cmbTo->currentData().toInt();
+    q.typeClass    = m_cmbClass->currentData().toString();
+    q.altitudeBand = m_cmbAlt->currentData().toInt();
+    q.idPrefix     = m_search->text().trimmed();
+    m_filter->setQuery(q);
 }
 
 void MainWindow::centerMap(double lat, double lon)
@@ -219,6 +319,23 @@ void MainWindow::centerMap(double lat, double lon)
     root->setProperty("centerLon", lon);
 }
 
+// Follows the selected flight however it was selected; refetches only when a
+// new flight is picked or the current one crosses into another centre tile.
+void MainWindow::prefetchSelected(bool force)
+{
+    if (!m_tiles || !m_tiles->isServing() || !m_selected->isValid() || !m_map || !m_map->rootObject())
+        return;
+
+    const int zoom = qBound(0, qRound(m_map->rootObject()->property("mapZoom").toDouble()), TilePackFormat::kMaxZoom);
+    const QPoint c = TileServer::tileAt(m_selected->latitude(), m_selected->longitude(), zoom);
+    const quint64 key = TilePackFormat::key(zoom, c.x(), c.y());
+    if (!force && key == m_prefetchTile)
+        return;
+
+    m_prefetchTile = key;
+    m_tiles->prefetchAround(m_selected->latitude(), m_selected->longitude(), zoom);
+}
+
 
 void MainWindow::onConnectClicked()
 {
@@ -5,36 +5,48 @@
 #include <QMainWindow>
 
 
-class QListView; class QLabel; class QLineEdit; class QPushButton;
-class QQuickWidget; class QQmlContext;
-class FlightModel; class RadarClient;
+class QListView; class QLabel; class QLineEdit; class QPushButton; class QComboBox;
+class QQuickWidget; class QQmlContext; class QTableView;
+class FlightModel; class FlightFilterModel; class AirportTrafficModel; class RadarClient; class TileServer; class SelectedFlight;
 
 class MainWindow : public QMainWindow {
     Q_OBJECT
 public:
-    explicit MainWindow(FlightModel* model, RadarClient* radar, QWidget* parent=nullptr);
+    explicit MainWindow(FlightModel* model, RadarClient* radar, TileServer* tiles, QWidget* parent=nullptr);
 
 private slots:
     void onRowChanged(const QModelIndex& current);
     void onConnectClicked();
     void onDisconnectClicked();
+    void onFilterChanged();
 
 private:
     FlightModel* m_model;
+    FlightFilterModel* m_filter;
+    AirportTrafficModel* m_traffic;
     RadarClient* m_radar;
+    TileServer*  m_tiles;
+    SelectedFlight* m_selected;
 
     QListView*   m_list;
+    QLineEdit*   m_search;
+    QComboBox*   m_cmbFrom; QComboBox* m_cmbTo; QComboBox* m_cmbClass; QComboBox* m_cmbAlt;
+    bool         m_syncingList = false;
     QLabel*      m_lblId; QLabel* m_lblType; QLabel* m_lblClass;
     QLabel*      m_lblFrom; QLabel* m_lblTo; QLabel* m_lblLatLon;
     QLabel*      m_lblAlt; QLabel* m_lblSeen;
+    QTableView*  m_board;
 
     QLineEdit*   m_host; QLineEdit* m_port;
     QPushButton* m_btnConn; QPushButton* m_btnDis;
 
-    QQuickWidget* m_map;
+    QQuickWidget* m_map = nullptr;
+    quint64      m_prefetchTile = ~quint64(0);   // pack key of the last prefetch centre
 
-    void updateDetails(int row);
+    void bindDetails();
+    void syncListToSelection();
     void centerMap(double lat, double lon);
+    void prefetchSelected(bool force);
 
 
 };
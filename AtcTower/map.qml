@@ -7,14 +7,38 @@ Item {
     width: 800
     height: 600
 
-    property int  currentIndex: -1
-    property var  selectedCoord: null
+    property var  selectedCoord: selectedFlight.valid
+                                 ? root.extrapolate(selectedFlight.filteredLatitude, selectedFlight.filteredLongitude,
+                                                    selectedFlight.vNorth, selectedFlight.vEast,
+                                                    selectedFlight.fixTime)
+                                 : null
 
     property double centerLat: 35.5
     property double centerLon: 51.5
 
     property color neon: "#39ff14"
 
+    readonly property real mapZoom: map.zoomLevel
+
+    // Dead reckoning: markers move from the filtered position at fixTime
+    // along the filtered velocity at display rate, up to maxExtrapolationSec.
+    property double nowMs: Date.now()
+    property real maxExtrapolationSec: 5
+    readonly property real metersPerDegLat: 111320
+
+    function extrapolate(lat, lon, vNorth, vEast, fixTime) {
+        var dt = Math.max(0, Math.min(maxExtrapolationSec, (nowMs - fixTime) / 1000))
+        return QtPositioning.coordinate(lat + vNorth * dt / metersPerDegLat,
+                                        lon + vEast * dt / (metersPerDegLat * Math.cos(lat * Math.PI / 180)))
+    }
+
+    Timer {
+        interval: 33
+        running: root.visible
+        repeat: true
+        onTriggered: root.nowMs = Date.now()
+    }
+
     property var trailPath: []
     property int maxTrailPoints: 90
     property real minTrailStepMeters: 250
@@ -43,13 +67,17 @@ Item {
     }
 
 
-    function airportById(aid) {
-        if (!airportList) return null
-        for (var i = 0; i < airportList.length; i++) {
-            var a = airportList[i]
-            if (a && a.id === aid) return a
+    Connections {
+        target: selectedFlight
+        function onFlightIdChanged() {
+            root.resetTrail(selectedFlight.valid
+                            ? QtPositioning.coordinate(selectedFlight.latitude, selectedFlight.longitude)
+                            : null)
+        }
+        function onPositionChanged() {
+            if (selectedFlight.valid)
+                root.appendTrail(QtPositioning.coordinate(selectedFlight.latitude, selectedFlight.longitude))
         }
-        return null
     }
 
 
@@ -59,7 +87,7 @@ Item {
 
         PluginParameter { name: "osm.mapping.providersrepository.disabled"; value: true }
 
-        PluginParameter { name: "osm.mapping.custom.host"; value: "https://a.basemaps.cartocdn.com/dark_all" }
+        PluginParameter { name: "osm.mapping.custom.host"; value: tileHost }
 
         PluginParameter {
             name: "osm.mapping.custom.mapcopyright"
@@ -170,8 +198,9 @@ Item {
             id: trailHead
             z: 4
             visible: root.trailPath.length > 0
-            coordinate: root.trailPath.length > 0 ? root.trailPath[root.trailPath.length - 1]
-                                                  : QtPositioning.coordinate(root.centerLat, root.centerLon)
+            coordinate: root.selectedCoord ? root.selectedCoord
+                                           : root.trailPath.length > 0 ? root.trailPath[root.trailPath.length - 1]
+                                                                       : QtPositioning.coordinate(root.centerLat, root.centerLon)
 
             anchorPoint.x: 10
             anchorPoint.y: 10
@@ -259,19 +288,15 @@ Item {
             }
         }
 
-        //Arrival markers
+        //Arrival markers, one per airport with arrivals
         MapItemView {
-            model: flightModel
+            model: airportTraffic
 
             delegate: MapQuickItem {
                 z: 4
-                visible: arrived
+                visible: arrived > 0
 
-                property var a: root.airportById(dstAirportId)
-
-
-                coordinate: a ? QtPositioning.coordinate(a.latitude, a.longitude)
-                              : QtPositioning.coordinate(latitude, longitude)
+                coordinate: QtPositioning.coordinate(latitude, longitude)
 
                 anchorPoint.x: 14
                 anchorPoint.y: 14
@@ -331,7 +356,7 @@ Item {
                         Text {
                             id: txt
                             anchors.centerIn: parent
-                            text: a ? ("ARRIVED • " + a.name) : "ARRIVED"
+                            text: "ARRIVED • " + name + (arrived > 1 ? " ×" + arrived : "")
                             color: "#FFC107"
                             font.pixelSize: 11
                             font.family: "monospace"
@@ -344,66 +369,21 @@ Item {
         //Flights
         MapItemView {
             id: flightsView
-            model: flightModel
+            model: flightFilter
 
             delegate: MapQuickItem {
                 id: flightItem
                 z: 6
 
-                property real lat: latitude
-                property real lon: longitude
                 property real hdg: heading
 
-                coordinate: QtPositioning.coordinate(lat, lon)
+                coordinate: root.extrapolate(filteredLatitude, filteredLongitude, vNorth, vEast, fixTime)
                 rotation: hdg
 
                 anchorPoint.x: planeImg.width / 2
                 anchorPoint.y: planeImg.height / 2
 
-                function updateSelectedCoordIfNeeded(resetTrailAlso) {
-                    if (index === root.currentIndex) {
-                        var c = QtPositioning.coordinate(lat, lon)
-                        root.selectedCoord = c
-
-                        if (resetTrailAlso === true) {
-                            root.resetTrail(c)
-                        } else {
-                            root.appendTrail(c)
-                        }
-                    }
-                }
-
-                Timer {
-                    id: trailCoalesce
-                    interval: 0
-                    repeat: false
-                    onTriggered: flightItem.updateSelectedCoordIfNeeded(false)
-                }
-
-                onLatChanged: {
-                    if (index === root.currentIndex)
-                        trailCoalesce.restart()
-                }
-
-                onLonChanged: {
-                    if (index === root.currentIndex)
-                        trailCoalesce.restart()
-                }
-
-
-                Connections {
-                    target: root
-                    function onCurrentIndexChanged() {
-                        flightItem.updateSelectedCoordIfNeeded(true)
-                    }
-                }
-
-                Component.onCompleted: {
-                    updateSelectedCoordIfNeeded(true)
-                }
-
-
-                property bool selected: (index === root.currentIndex)
+                property bool selected: (flightId === selectedFlight.flightId)
                 property real targetScale: selected ? 1.20 : 1.0
 
                 sourceItem: Item {
@@ -437,8 +417,7 @@ Item {
                     MouseArea {
                         anchors.fill: parent
                         onClicked: {
-                            root.currentIndex = index
-                            root.selectedCoord = QtPositioning.coordinate(flightItem.lat, flightItem.lon)
+                            selectedFlight.select(flightId)
                         }
                     }
                 }
@@ -450,7 +429,7 @@ Item {
             id: radarCanvas
             anchors.fill: parent
             z: 10
-            visible: root.currentIndex >= 0 && root.selectedCoord
+            visible: root.selectedCoord !== null
             antialiasing: true
 
             property real radarAngle: 0.0
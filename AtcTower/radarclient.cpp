@@ -2,9 +2,6 @@
 #include <QtEndian>
 
 
-static const QByteArray kHeader("\xA5\xA5\xA5\xA5", 4);
-static const QByteArray kFooter("\x55\x55\x55\x55", 4);
-static const int kFrameSize = 39;
 static constexpr int kMaxBufferSize = 1024 * 1024; 
 
 
@@ -59,59 +56,7 @@ void RadarClient::onReadyRead()
         return;
     }
 
-    while (true) {
-        FlightRecord rec;
-        if (!tryExtractFrame(m_buffer, rec))
-            break;
-        if (!rec.isValid()) {
-            qWarning() << "[radar] dropped invalid record" << rec.flightId
-                       << "type" << rec.typeId
-                       << "src" << rec.srcAirportId
-                       << "dst" << rec.dstAirportId
-                       << "lat" << rec.latitude()
-                       << "lon" << rec.longitude()
-                       << "alt" << rec.altitude;
-
-            continue;
-        }
+    RadarFrame::consume(m_buffer, m_batch, m_accepted);
+    for (const FlightRecord& rec : std::as_const(m_accepted))
         emit flightReceived(rec);
-    }
-}
-
-bool RadarClient::tryExtractFrame(QByteArray& buffer, FlightRecord& out)
-{
-    int pos = buffer.indexOf(kHeader);
-    if (pos < 0) { buffer.clear(); return false; }
-    if (buffer.size() < pos + kFrameSize) return false;
-
-    QByteArray frame = buffer.mid(pos, kFrameSize);
-
-    if (memcmp(frame.constData() + 35, kFooter.constData(), 4) != 0) {
-
-        buffer.remove(0, pos + 1);
-        return false;
-    }
-
-
-    const uchar* d = reinterpret_cast<const uchar*>(frame.constData());
-
-    out.typeId        = d[4];
-    out.srcAirportId  = d[5];
-    out.dstAirportId  = d[6];
-
-    out.latitudeRaw   = qFromLittleEndian<quint32>(d + 7);
-    out.latitudeFactor= qFromLittleEndian<quint16>(d + 11);
-    out.longitudeRaw  = qFromLittleEndian<quint32>(d + 13);
-    out.longitudeFactor=qFromLittleEndian<quint16>(d + 17);
-    out.altitude      = qFromLittleEndian<quint32>(d + 19);
-    out.flightId      = qFromLittleEndian<quint32>(d + 23);
-
-
-    buffer.remove(0, pos + kFrameSize);
-    return true;
-
 }
-
-
-
-
@@ -6,6 +6,7 @@
 #include <QTcpSocket>
 #include <QByteArray>
 #include "Types.h"
+#include "framedecoder.h"
 
 class RadarClient : public QObject {
     Q_OBJECT
@@ -27,10 +28,10 @@ private slots:
     void onReadyRead();
 
 private:
-    bool tryExtractFrame(QByteArray& buffer, FlightRecord& out);
-
     QTcpSocket m_socket;
     QByteArray m_buffer;
+    FrameBatch m_batch;
+    QVector<FlightRecord> m_accepted;
 };
 
 #endif // RADARCLIENT_H
@@ -0,0 +1,95 @@
+#include "selectedflight.h"
+#include "flightmodel.h"
+
+
+SelectedFlight::SelectedFlight(FlightModel* model, QObject* parent)
+    : QObject(parent), m_model(model)
+{
+    connect(m_model, &QAbstractItemModel::dataChanged, this,
+            [this](const QModelIndex& topLeft, const QModelIndex& bottomRight, const QVector<int>&)
+            {
+                if (m_row >= 0 && topLeft.row() <= m_row && m_row <= bottomRight.row())
+                    refresh(m_row);
+            });
+
+    connect(m_model, &QAbstractItemModel::modelReset, this, [this]{
+        refresh(m_flightId ? m_model->rowOf(m_flightId) : -1);
+    });
+}
+
+QString SelectedFlight::typeName() const  { return aircraftCatalog().value(quint8(m_typeId)).name; }
+QString SelectedFlight::typeClass() const { return aircraftCatalog().value(quint8(m_typeId)).type; }
+QString SelectedFlight::srcAirport() const { return airportCatalog().value(quint8(m_srcId)).name; }
+QString SelectedFlight::srcCountry() const { return airportCatalog().value(quint8(m_srcId)).country; }
+QString SelectedFlight::dstAirport() const { return airportCatalog().value(quint8(m_dstId)).name; }
+QString SelectedFlight::dstCountry() const { return airportCatalog().value(quint8(m_dstId)).country; }
+
+void SelectedFlight::select(quint32 flightId)
+{
+    refresh(m_model->rowOf(flightId));
+}
+
+void SelectedFlight::selectRow(int row)
+{
+    refresh(row);
+}
+
+void SelectedFlight::refresh(int row)
+{
+    const FlightModel::Item* it = m_model->item(row);
+    if (!it)
+        row = -1;
+
+    const quint32   flightId = it ? it->rec.flightId : 0u;
+    const int       typeId   = it ? it->rec.typeId : -1;
+    const int       srcId    = it ? it->rec.srcAirportId : -1;
+    const int       dstId    = it ? it->rec.dstAirportId : -1;
+    const double    lat      = it ? it->rec.latitude() : 0.0;
+    const double    lon      = it ? it->rec.longitude() : 0.0;
+    const quint32   alt      = it ? it->rec.altitude : 0u;
+    const QDateTime seen     = it ? it->lastSeen : QDateTime();
+    const double    vNorth   = it ? it->vNorth : 0.0;
+    const double    vEast    = it ? it->vEast : 0.0;
+    const double    climb    = it ? it->climbRate : 0.0;
+    const qint64    fixMs    = it ? it->fixMs : 0;
+    const double    estLat   = it ? it->estLat : 0.0;
+    const double    estLon   = it ? it->estLon : 0.0;
+
+    // Update everything first so handlers of any signal see a consistent flight.
+    const bool rowCh  = (m_row != row);
+    const bool idCh   = (m_flightId != flightId);
+    const bool typeCh = (m_typeId != typeId);
+    const bool srcCh  = (m_srcId != srcId);
+    const bool dstCh  = (m_dstId != dstId);
+    const bool posCh  = (m_lat != lat || m_lon != lon);
+    const bool altCh  = (m_alt != alt);
+    const bool seenCh = (m_lastSeen != seen);
+    const bool motCh  = (m_vNorth != vNorth || m_vEast != vEast || m_climb != climb || m_fixMs != fixMs
+                         || m_estLat != estLat || m_estLon != estLon);
+
+    m_row      = row;
+    m_flightId = flightId;
+    m_typeId   = typeId;
+    m_srcId    = srcId;
+    m_dstId    = dstId;
+    m_lat      = lat;
+    m_lon      = lon;
+    m_alt      = alt;
+    m_lastSeen = seen;
+    m_vNorth   = vNorth;
+    m_vEast    = vEast;
+    m_climb    = climb;
+    m_fixMs    = fixMs;
+    m_estLat   = estLat;
+    m_estLon   = estLon;
+
+    if (rowCh)  emit rowChanged();
+    if (idCh)   emit flightIdChanged();
+    if (typeCh) emit typeChanged();
+    if (srcCh)  emit srcAirportChanged();
+    if (dstCh)  emit dstAirportChanged();
+    if (posCh)  emit positionChanged();
+    if (altCh)  emit altitudeChanged();
+    if (seenCh) emit lastSeenChanged();
+    if (motCh)  emit motionChanged();
+}
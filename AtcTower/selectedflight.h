@@ -0,0 +1,105 @@
+#ifndef SELECTEDFLIGHT_H
+#define SELECTEDFLIGHT_H
+
+#pragma once
+#include <QObject>
+#include <QString>
+#include <QDateTime>
+#include <cmath>
+
+class FlightModel;
+
+// The currently selected flight as typed properties. Each NOTIFY signal is
+// emitted only when that field actually changed, so a position update only
+// touches whatever is bound to latitude/longitude and lastSeen.
+class SelectedFlight : public QObject {
+    Q_OBJECT
+    Q_PROPERTY(int       row          READ row          NOTIFY rowChanged)
+    Q_PROPERTY(bool      valid        READ isValid      NOTIFY rowChanged)
+    Q_PROPERTY(quint32   flightId     READ flightId     NOTIFY flightIdChanged)
+    Q_PROPERTY(int       typeId       READ typeId       NOTIFY typeChanged)
+    Q_PROPERTY(QString   typeName     READ typeName     NOTIFY typeChanged)
+    Q_PROPERTY(QString   typeClass    READ typeClass    NOTIFY typeChanged)
+    Q_PROPERTY(int       srcAirportId READ srcAirportId NOTIFY srcAirportChanged)
+    Q_PROPERTY(QString   srcAirport   READ srcAirport   NOTIFY srcAirportChanged)
+    Q_PROPERTY(QString   srcCountry   READ srcCountry   NOTIFY srcAirportChanged)
+    Q_PROPERTY(int       dstAirportId READ dstAirportId NOTIFY dstAirportChanged)
+    Q_PROPERTY(QString   dstAirport   READ dstAirport   NOTIFY dstAirportChanged)
+    Q_PROPERTY(QString   dstCountry   READ dstCountry   NOTIFY dstAirportChanged)
+    Q_PROPERTY(double    latitude     READ latitude     NOTIFY positionChanged)
+    Q_PROPERTY(double    longitude    READ longitude    NOTIFY positionChanged)
+    Q_PROPERTY(quint32   altitude     READ altitude     NOTIFY altitudeChanged)
+    Q_PROPERTY(double    vNorth       READ vNorth       NOTIFY motionChanged)
+    Q_PROPERTY(double    vEast        READ vEast        NOTIFY motionChanged)
+    Q_PROPERTY(double    fixTime      READ fixTime      NOTIFY motionChanged)
+    Q_PROPERTY(double    groundSpeed  READ groundSpeed  NOTIFY motionChanged)
+    Q_PROPERTY(double    climbRate    READ climbRate    NOTIFY motionChanged)
+    Q_PROPERTY(double    filteredLatitude  READ filteredLatitude  NOTIFY motionChanged)
+    Q_PROPERTY(double    filteredLongitude READ filteredLongitude NOTIFY motionChanged)
+    Q_PROPERTY(QDateTime lastSeen     READ lastSeen     NOTIFY lastSeenChanged)
+public:
+    explicit SelectedFlight(FlightModel* model, QObject* parent=nullptr);
+
+    int       row() const          { return m_row; }
+    bool      isValid() const      { return m_row >= 0; }
+    quint32   flightId() const     { return m_flightId; }
+    int       typeId() const       { return m_typeId; }
+    QString   typeName() const;
+    QString   typeClass() const;
+    int       srcAirportId() const { return m_srcId; }
+    QString   srcAirport() const;
+    QString   srcCountry() const;
+    int       dstAirportId() const { return m_dstId; }
+    QString   dstAirport() const;
+    QString   dstCountry() const;
+    double    latitude() const     { return m_lat; }
+    double    longitude() const    { return m_lon; }
+    quint32   altitude() const     { return m_alt; }
+    double    vNorth() const       { return m_vNorth; }
+    double    vEast() const        { return m_vEast; }
+    double    fixTime() const      { return double(m_fixMs); }
+    double    groundSpeed() const  { return std::hypot(m_vNorth, m_vEast); }
+    double    climbRate() const    { return m_climb; }
+    double    filteredLatitude() const  { return m_estLat; }
+    double    filteredLongitude() const { return m_estLon; }
+    QDateTime lastSeen() const     { return m_lastSeen; }
+
+public slots:
+    void select(quint32 flightId);
+    void selectRow(int row);
+    void clear() { selectRow(-1); }
+
+signals:
+    void rowChanged();
+    void flightIdChanged();
+    void typeChanged();
+    void srcAirportChanged();
+    void dstAirportChanged();
+    void positionChanged();
+    void altitudeChanged();
+    void motionChanged();
+    void lastSeenChanged();
+
+private:
+    void refresh(int row);
+
+    FlightModel* m_model;
+
+    int       m_row = -1;
+    quint32   m_flightId = 0;
+    int       m_typeId = -1;
+    int       m_srcId = -1;
+    int       m_dstId = -1;
+    double    m_lat = 0.0;
+    double    m_lon = 0.0;
+    quint32   m_alt = 0;
+    double    m_vNorth = 0.0;
+    double    m_vEast = 0.0;
+    double    m_climb = 0.0;
+    qint64    m_fixMs = 0;
+    double    m_estLat = 0.0;
+    double    m_estLon = 0.0;
+    QDateTime m_lastSeen;
+};
+
+#endif // SELECTEDFLIGHT_H
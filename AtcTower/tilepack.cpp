@@ -0,0 +1,98 @@
+#include "tilepack.h"
+#include <QtEndian>
+#include <QDebug>
+#include <cstring>
+
+
+bool TilePack::open(const QString& path)
+{
+    close();
+
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        qWarning() << "[tiles] cannot open pack" << path << m_file.errorString();
+        return false;
+    }
+
+    m_size = m_file.size();
+    if (m_size < TilePackFormat::kHeaderSize) {
+        qWarning() << "[tiles] pack too small" << path;
+        close();
+        return false;
+    }
+
+    const uchar* base = m_file.map(0, m_size);
+    if (!base) {
+        qWarning() << "[tiles] mmap failed" << path << m_file.errorString();
+        close();
+        return false;
+    }
+
+    const quint32 version     = qFromLittleEndian<quint32>(base + 8);
+    const quint32 count       = qFromLittleEndian<quint32>(base + 12);
+    const quint64 indexOffset = qFromLittleEndian<quint64>(base + 16);
+
+    if (memcmp(base, TilePackFormat::kMagic, 8) != 0 || version != TilePackFormat::kVersion) {
+        qWarning() << "[tiles] bad pack header" << path << "version" << version;
+        m_file.unmap(const_cast<uchar*>(base));
+        close();
+        return false;
+    }
+
+    if (indexOffset > quint64(m_size) ||
+        quint64(count) * TilePackFormat::kEntrySize > quint64(m_size) - indexOffset) {
+        qWarning() << "[tiles] truncated pack index" << path;
+        m_file.unmap(const_cast<uchar*>(base));
+        close();
+        return false;
+    }
+
+    m_base  = base;
+    m_index = base + indexOffset;
+    m_count = count;
+
+    qDebug() << "[tiles] mapped" << path << "tiles" << m_count << "bytes" << m_size;
+    return true;
+}
+
+void TilePack::close()
+{
+    if (m_base)
+        m_file.unmap(const_cast<uchar*>(m_base));
+    if (m_file.isOpen())
+        m_file.close();
+
+    m_base  = nullptr;
+    m_index = nullptr;
+    m_count = 0;
+    m_size  = 0;
+}
+
+QByteArray TilePack::tile(int z, int x, int y) const
+{
+    if (!m_base || !TilePackFormat::isValid(z, x, y))
+        return {};
+
+    const quint64 k = TilePackFormat::key(z, x, y);
+
+    quint32 lo = 0;
+    quint32 hi = m_count;
+    while (lo < hi) {
+        const quint32 mid = lo + (hi - lo) / 2;
+        const uchar*  e   = m_index + quint64(mid) * TilePackFormat::kEntrySize;
+        const quint64 ek  = qFromLittleEndian<quint64>(e);
+
+        if (ek < k) {
+            lo = mid + 1;
+        } else if (ek > k) {
+            hi = mid;
+        } else {
+            const quint64 off  = qFromLittleEndian<quint64>(e + 8);
+            const quint32 size = qFromLittleEndian<quint32>(e + 16);
+            if (off > quint64(m_size) || size > quint64(m_size) - off)
+                return {};
+            return QByteArray::fromRawData(reinterpret_cast<const char*>(m_base + off), size);
+        }
+    }
+    return {};
+}
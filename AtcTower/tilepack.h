@@ -0,0 +1,58 @@
+#ifndef TILEPACK_H
+#define TILEPACK_H
+
+#pragma once
+#include <QFile>
+#include <QByteArray>
+#include <QString>
+
+// Flat basemap tile pack, memory-mapped read-only.
+//
+// Layout (all integers little endian):
+//   header  : magic "ATCTILE1", quint32 version, quint32 count, quint64 indexOffset
+//   index   : count x { quint64 key, quint64 offset, quint32 size, quint32 reserved }, sorted by key
+//   payload : encoded tile images (PNG/JPEG) exactly as found in the source z/x/y directory
+namespace TilePackFormat {
+static constexpr char    kMagic[8]    = { 'A','T','C','T','I','L','E','1' };
+static constexpr quint32 kVersion     = 1;
+static constexpr int     kHeaderSize  = 24;
+static constexpr int     kEntrySize   = 24;
+static constexpr int     kMaxZoom     = 28;   // x and y get 28 bits each in the key
+
+// Keys only round-trip inside this range; check before building one.
+inline bool isValid(int z, int x, int y)
+{
+    return z >= 0 && z <= kMaxZoom && x >= 0 && y >= 0 && x < (1 << z) && y < (1 << z);
+}
+
+inline quint64 key(int z, int x, int y)
+{
+    return (quint64(quint8(z)) << 56) | (quint64(quint32(x) & 0xFFFFFFFu) << 28) | quint64(quint32(y) & 0xFFFFFFFu);
+}
+}
+
+class TilePack {
+public:
+    TilePack() = default;
+    ~TilePack() { close(); }
+    TilePack(const TilePack&) = delete;
+    TilePack& operator=(const TilePack&) = delete;
+
+    bool open(const QString& path);
+    void close();
+    bool isOpen() const { return m_base != nullptr; }
+    quint32 count() const { return m_count; }
+
+    // Returns a view into the mapping (no copy); empty if the tile is missing.
+    // Valid until close().
+    QByteArray tile(int z, int x, int y) const;
+
+private:
+    QFile        m_file;
+    const uchar* m_base = nullptr;
+    qint64       m_size = 0;
+    const uchar* m_index = nullptr;
+    quint32      m_count = 0;
+};
+
+#endif // TILEPACK_H
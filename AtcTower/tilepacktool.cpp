@@ -0,0 +1,125 @@
+#include <QCoreApplication>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QMap>
+#include <QSaveFile>
+#include <QRegularExpression>
+#include <QtEndian>
+#include <QDebug>
+#include "tilepack.h"
+
+// Builds a basemap tile pack from a local z/x/y.{png,jpg} tile directory,
+// e.g. one exported from a tile server or a tile downloader:
+//
+//   tilepack <tileDir> <out.tilepack>
+
+
+static void appendLe32(QByteArray& b, quint32 v)
+{
+    uchar tmp[4];
+    qToLittleEndian<quint32>(v, tmp);
+    b.append(reinterpret_cast<const char*>(tmp), 4);
+}
+
+static void appendLe64(QByteArray& b, quint64 v)
+{
+    uchar tmp[8];
+    qToLittleEndian<quint64>(v, tmp);
+    b.append(reinterpret_cast<const char*>(tmp), 8);
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    const QStringList args = app.arguments();
+    if (args.size() != 3) {
+        qWarning().noquote() << "usage:" << QFileInfo(args.value(0)).fileName() << "<tileDir> <out.tilepack>";
+        return 2;
+    }
+
+    const QDir root(args.at(1));
+    if (!root.exists()) {
+        qWarning() << "[tilepack] no such directory" << args.at(1);
+        return 1;
+    }
+
+    static const QRegularExpression re(QStringLiteral(R"(^(\d+)/(\d+)/(\d+)\.(png|jpg|jpeg|webp)$)"),
+                                       QRegularExpression::CaseInsensitiveOption);
+
+    QMap<quint64, QString> tiles;
+    QDirIterator dit(root.absolutePath(), QDir::Files, QDirIterator::Subdirectories);
+    while (dit.hasNext()) {
+        const QString path = dit.next();
+        const QRegularExpressionMatch m = re.match(root.relativeFilePath(path));
+        if (!m.hasMatch())
+            continue;
+
+        bool okZ = false, okX = false, okY = false;
+        const int z = m.captured(1).toInt(&okZ);
+        const int x = m.captured(2).toInt(&okX);
+        const int y = m.captured(3).toInt(&okY);
+        if (!okZ || !okX || !okY || !TilePackFormat::isValid(z, x, y)) {
+            qWarning() << "[tilepack] skipping out-of-range tile" << path;
+            continue;
+        }
+        tiles.insert(TilePackFormat::key(z, x, y), path);
+    }
+
+    if (tiles.isEmpty()) {
+        qWarning() << "[tilepack] no z/x/y tiles found under" << root.absolutePath();
+        return 1;
+    }
+
+    const quint64 indexOffset = TilePackFormat::kHeaderSize;
+    quint64 dataOffset = indexOffset + quint64(tiles.size()) * TilePackFormat::kEntrySize;
+
+    QByteArray head;
+    head.reserve(int(dataOffset));
+    head.append(TilePackFormat::kMagic, 8);
+    appendLe32(head, TilePackFormat::kVersion);
+    appendLe32(head, quint32(tiles.size()));
+    appendLe64(head, indexOffset);
+
+    for (auto it = tiles.cbegin(); it != tiles.cend(); ++it) {
+        const qint64 size = QFileInfo(it.value()).size();
+        appendLe64(head, it.key());
+        appendLe64(head, dataOffset);
+        appendLe32(head, quint32(size));
+        appendLe32(head, 0);
+        dataOffset += quint64(size);
+    }
+
+    QSaveFile out(args.at(2));
+    if (!out.open(QIODevice::WriteOnly)) {
+        qWarning() << "[tilepack] cannot write" << args.at(2) << out.errorString();
+        return 1;
+    }
+    out.write(head);
+
+    for (auto it = tiles.cbegin(); it != tiles.cend(); ++it) {
+        QFile in(it.value());
+        if (!in.open(QIODevice::ReadOnly)) {
+            qWarning() << "[tilepack] cannot read" << it.value() << in.errorString();
+            out.cancelWriting();
+            return 1;
+        }
+        const QByteArray bytes = in.readAll();
+        if (bytes.size() != in.size()) {
+            qWarning() << "[tilepack] short read" << it.value();
+            out.cancelWriting();
+            return 1;
+        }
+        out.write(bytes);
+    }
+
+    if (!out.commit()) {
+        qWarning() << "[tilepack] commit failed" << args.at(2) << out.errorString();
+        return 1;
+    }
+
+    qDebug().noquote() << "[tilepack] wrote" << tiles.size() << "tiles," << dataOffset << "bytes to" << args.at(2);
+    return 0;
+}
@@ -0,0 +1,140 @@
+#include "tileserver.h"
+#include <QTcpSocket>
+#include <QRegularExpression>
+#include <QDebug>
+#include <QtMath>
+
+static constexpr int kCacheKiB      = 64 * 1024;
+static constexpr int kPrefetchRing  = 2;
+
+
+TileServer::TileServer(QObject* parent) : QObject(parent)
+{
+    m_cache.setMaxCost(kCacheKiB);
+    connect(&m_server, &QTcpServer::newConnection, this, &TileServer::onNewConnection);
+}
+
+bool TileServer::start(const QString& packPath)
+{
+    if (!m_pack.open(packPath))
+        return false;
+
+    if (!m_server.listen(QHostAddress::LocalHost, 0)) {
+        qWarning() << "[tiles] listen failed" << m_server.errorString();
+        m_pack.close();
+        return false;
+    }
+
+    qDebug() << "[tiles] serving" << m_pack.count() << "tiles at" << hostUrl();
+    return true;
+}
+
+QString TileServer::hostUrl() const
+{
+    return QStringLiteral("http://127.0.0.1:%1/").arg(m_server.serverPort());
+}
+
+QByteArray TileServer::tile(int z, int x, int y)
+{
+    if (!TilePackFormat::isValid(z, x, y))
+        return {};
+
+    const quint64 k = TilePackFormat::key(z, x, y);
+
+    if (const QByteArray* hit = m_cache.object(k))
+        return *hit;
+
+    const QByteArray view = m_pack.tile(z, x, y);
+    if (view.isEmpty())
+        return {};
+
+    // Deep copy: keeps hot tiles resident even when the OS drops mapped pages.
+    auto *copy = new QByteArray(view.constData(), view.size());
+    const QByteArray out = *copy;
+    m_cache.insert(k, copy, qMax(1, int(copy->size() / 1024)));
+    return out;
+}
+
+QPoint TileServer::tileAt(double lat, double lon, int z)
+{
+    const double latRad = qDegreesToRadians(qBound(-85.0511, lat, 85.0511));
+    const int n = 1 << z;
+    return QPoint(qBound(0, int(std::floor((lon + 180.0) / 360.0 * n)), n - 1),
+                  qBound(0, int(std::floor((1.0 - std::log(std::tan(latRad) + 1.0 / std::cos(latRad)) / M_PI) / 2.0 * n)), n - 1));
+}
+
+void TileServer::prefetchAround(double lat, double lon, int zoom)
+{
+    if (!m_pack.isOpen())
+        return;
+
+    for (int z = qMax(0, zoom - 1); z <= qMin(TilePackFormat::kMaxZoom, zoom + 1); ++z) {
+        const int n  = 1 << z;
+        const QPoint c = tileAt(lat, lon, z);
+        const int cx = c.x();
+        const int cy = c.y();
+        const int ring = (z == zoom) ? kPrefetchRing : 1;
+
+        for (int dy = -ring; dy <= ring; ++dy) {
+            const int y = cy + dy;
+            if (y < 0 || y >= n)
+                continue;
+            for (int dx = -ring; dx <= ring; ++dx) {
+                const int x = (cx + dx + n) % n;
+                tile(z, x, y);
+            }
+        }
+    }
+}
+
+void TileServer::onNewConnection()
+{
+    while (QTcpSocket *s = m_server.nextPendingConnection()) {
+        connect(s, &QTcpSocket::readyRead, this, [this, s]{ handleRequest(s); });
+        connect(s, &QTcpSocket::disconnected, s, &QObject::deleteLater);
+    }
+}
+
+void TileServer::handleRequest(QTcpSocket* s)
+{
+    if (!s->canReadLine())
+        return;
+
+    // One request per connection; header lines arriving later are not a new request.
+    disconnect(s, &QTcpSocket::readyRead, this, nullptr);
+
+    // Only the request line matters; "GET /<z>/<x>/<y>.png HTTP/1.1"
+    const QList<QByteArray> parts = s->readLine().trimmed().split(' ');
+    s->readAll();
+
+    static const QRegularExpression re(QStringLiteral(R"((\d+)/(\d+)/(\d+)\.\w+)"));
+
+    QByteArray body;
+    if (parts.size() >= 2 && parts.at(0) == "GET") {
+        const QRegularExpressionMatch m = re.match(QString::fromLatin1(parts.at(1)));
+        bool okZ = false, okX = false, okY = false;
+        if (m.hasMatch()) {
+            const int z = m.captured(1).toInt(&okZ);
+            const int x = m.captured(2).toInt(&okX);
+            const int y = m.captured(3).toInt(&okY);
+            if (okZ && okX && okY)
+                body = tile(z, x, y);
+        }
+    }
+
+    QByteArray resp;
+    if (body.isEmpty()) {
+        resp = "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+    } else {
+        const char* type = body.startsWith("\x89PNG") ? "image/png"
+                         : body.startsWith("RIFF")    ? "image/webp"
+                                                      : "image/jpeg";
+        resp = "HTTP/1.1 200 OK\r\nContent-Type: " + QByteArray(type)
+             + "\r\nContent-Length: " + QByteArray::number(body.size())
+             + "\r\nCache-Control: max-age=86400\r\nConnection: close\r\n\r\n";
+        resp += body;
+    }
+
+    s->write(resp);
+    s->disconnectFromHost();
+}
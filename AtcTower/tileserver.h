@@ -0,0 +1,44 @@
+#ifndef TILESERVER_H
+#define TILESERVER_H
+
+#pragma once
+#include <QObject>
+#include <QTcpServer>
+#include <QCache>
+#include <QByteArray>
+#include <QPoint>
+#include "tilepack.h"
+
+class QTcpSocket;
+
+// Serves basemap tiles from a local tile pack over loopback HTTP, so the
+// QtLocation OSM plugin can use it as its custom host without any network.
+class TileServer : public QObject {
+    Q_OBJECT
+public:
+    explicit TileServer(QObject* parent=nullptr);
+
+    bool start(const QString& packPath);
+    bool isServing() const { return m_server.isListening(); }
+    QString hostUrl() const;
+
+    QByteArray tile(int z, int x, int y);
+
+    // Slippy-map tile containing lat/lon at zoom z.
+    static QPoint tileAt(double lat, double lon, int z);
+
+public slots:
+    void prefetchAround(double lat, double lon, int zoom);
+
+private slots:
+    void onNewConnection();
+
+private:
+    void handleRequest(QTcpSocket* s);
+
+    TilePack   m_pack;
+    QTcpServer m_server;
+    QCache<quint64, QByteArray> m_cache;   // cost in KiB
+};
+
+#endif // TILESERVER_H
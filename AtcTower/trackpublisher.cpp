@@ -0,0 +1,106 @@
+#include "trackpublisher.h"
+#include <QDateTime>
+#include <QThread>
+#include <algorithm>
+
+// Marks a slot as claimed by a reader that has not pinned a version yet.
+static const TrackTableView kClaimed;
+
+
+TrackPublisher::TrackPublisher(FlightModel* model, QObject* parent)
+    : QObject(parent), m_model(model)
+{
+    auto markDirty = [this]{ m_dirty = true; };
+    connect(m_model, &QAbstractItemModel::dataChanged,  this, markDirty);
+    connect(m_model, &QAbstractItemModel::rowsInserted, this, markDirty);
+    connect(m_model, &QAbstractItemModel::modelReset,   this, markDirty);
+    connect(&m_timer, &QTimer::timeout, this, &TrackPublisher::publish);
+
+    for (auto& s : m_slots)
+        s.store(nullptr, std::memory_order_relaxed);
+
+    m_current.store(new TrackTableView, std::memory_order_release);
+}
+
+TrackPublisher::~TrackPublisher()
+{
+    // Readers must be gone by now; nothing can pin a version any more.
+    m_timer.stop();
+    delete m_current.load(std::memory_order_acquire);
+    for (const TrackTableView* v : m_retired)
+        delete v;
+}
+
+void TrackPublisher::start(int intervalMs)
+{
+    publish();
+    m_timer.start(intervalMs);
+}
+
+TrackPublisher::Reader TrackPublisher::read() const
+{
+    std::atomic<const TrackTableView*>* slot = nullptr;
+    while (!slot) {
+        for (auto& s : m_slots) {
+            const TrackTableView* expected = nullptr;
+            if (s.compare_exchange_strong(expected, &kClaimed, std::memory_order_acq_rel)) {
+                slot = &s;
+                break;
+            }
+        }
+        if (!slot)
+            QThread::yieldCurrentThread();
+    }
+
+    // Pin, then re-check that the pinned version is still current; otherwise
+    // the writer may already have scanned the slots and freed it.
+    const TrackTableView* v = m_current.load(std::memory_order_seq_cst);
+    for (;;) {
+        slot->store(v, std::memory_order_seq_cst);
+        const TrackTableView* now = m_current.load(std::memory_order_seq_cst);
+        if (now == v)
+            break;
+        v = now;
+    }
+    return Reader(slot, v);
+}
+
+void TrackPublisher::publish()
+{
+    if (!m_dirty) {
+        reclaim();
+        return;
+    }
+    m_dirty = false;
+
+    auto *next = new TrackTableView;
+    next->version       = ++m_version;
+    next->publishedAtMs = QDateTime::currentMSecsSinceEpoch();
+    next->items         = m_model->items();   // implicitly shared; FlightModel detaches on its next write
+
+    const TrackTableView* prev = m_current.exchange(next, std::memory_order_seq_cst);
+    m_retired.push_back(prev);
+    reclaim();
+}
+
+void TrackPublisher::reclaim()
+{
+    if (m_retired.empty())
+        return;
+
+    std::array<const TrackTableView*, kReaderSlots> pinned;
+    for (int i = 0; i < kReaderSlots; ++i)
+        pinned[i] = m_slots[i].load(std::memory_order_seq_cst);
+
+    auto inUse = [&](const TrackTableView* v) {
+        return std::find(pinned.cbegin(), pinned.cend(), v) != pinned.cend();
+    };
+
+    auto keep = std::remove_if(m_retired.begin(), m_retired.end(), [&](const TrackTableView* v) {
+        if (inUse(v))
+            return false;
+        delete v;
+        return true;
+    });
+    m_retired.erase(keep, m_retired.end());
+}
@@ -0,0 +1,74 @@
+#ifndef TRACKPUBLISHER_H
+#define TRACKPUBLISHER_H
+
+#pragma once
+#include <QObject>
+#include <QTimer>
+#include <array>
+#include <atomic>
+#include <vector>
+#include "flightmodel.h"
+
+// One immutable version of the track table.
+struct TrackTableView {
+    quint64 version = 0;
+    qint64  publishedAtMs = 0;
+    QVector<FlightModel::Item> items;
+};
+
+// Publishes an immutable TrackTableView of FlightModel once per tick (GUI
+// thread) for readers on any thread. Readers never lock and never block
+// ingest: read() pins the current version in a hazard slot, and the writer
+// only frees retired versions that no slot still points at.
+//
+// At most kReaderSlots readers can hold a view at the same time; further
+// readers spin until a slot frees up, so keep Reader lifetimes short.
+class TrackPublisher : public QObject {
+    Q_OBJECT
+public:
+    static constexpr int kReaderSlots = 32;
+
+    class Reader {
+    public:
+        Reader(Reader&& o) noexcept : m_slot(o.m_slot), m_view(o.m_view) { o.m_slot = nullptr; }
+        Reader(const Reader&) = delete;
+        Reader& operator=(const Reader&) = delete;
+        Reader& operator=(Reader&&) = delete;
+        ~Reader() { if (m_slot) m_slot->store(nullptr, std::memory_order_release); }
+
+        const TrackTableView& operator*() const  { return *m_view; }
+        const TrackTableView* operator->() const { return m_view; }
+
+    private:
+        friend class TrackPublisher;
+        Reader(std::atomic<const TrackTableView*>* slot, const TrackTableView* view) : m_slot(slot), m_view(view) {}
+
+        std::atomic<const TrackTableView*>* m_slot;
+        const TrackTableView* m_view;
+    };
+
+    explicit TrackPublisher(FlightModel* model, QObject* parent=nullptr);
+    ~TrackPublisher() override;
+
+    void start(int intervalMs);
+
+    // Safe from any thread. Always returns a view (empty before the first publish).
+    Reader read() const;
+
+public slots:
+    void publish();
+
+private:
+    void reclaim();
+
+    FlightModel* m_model;
+    QTimer       m_timer;
+    bool         m_dirty = true;
+    quint64      m_version = 0;
+
+    std::atomic<const TrackTableView*> m_current { nullptr };
+    mutable std::array<std::atomic<const TrackTableView*>, kReaderSlots> m_slots {};
+    std::vector<const TrackTableView*> m_retired;   // writer thread only
+};
+
+#endif // TRACKPUBLISHER_H
@@ -0,0 +1,195 @@
+#include "trackstore.h"
+#include "trackpublisher.h"
+#include <QFile>
+#include <QSaveFile>
+#include <QDir>
+#include <QFileInfo>
+#include <QSet>
+#include <QThreadPool>
+#include <QElapsedTimer>
+#include <QTimeZone>
+#include <QtEndian>
+#include <QDebug>
+#include <cstring>
+
+static constexpr char    kMagic[8]    = { 'A','T','C','T','R','K','\0','\0' };
+static constexpr quint32 kVersion     = 1;
+static constexpr int     kHeaderSize  = 32;
+
+// v1 record:
+//   0 flightId u32 | 4 typeId u8 | 5 src u8 | 6 dst u8 | 7 flags u8 (bit0 arrived)
+//   8 latRaw u32 | 12 latFactor u16 | 14 lonFactor u16 | 16 lonRaw u32 | 20 altitude u32
+//  24 lastSeenMs i64 | 32 headingDeg f64
+static constexpr int     kRecordSize  = 40;
+static constexpr quint8  kFlagArrived = 0x01;
+
+
+static void putDouble(uchar* p, double v)
+{
+    quint64 bits;
+    memcpy(&bits, &v, sizeof bits);
+    qToLittleEndian<quint64>(bits, p);
+}
+
+static double getDouble(const uchar* p)
+{
+    const quint64 bits = qFromLittleEndian<quint64>(p);
+    double v;
+    memcpy(&v, &bits, sizeof v);
+    return v;
+}
+
+
+TrackStore::TrackStore(FlightModel* model, const QString& path, QObject* parent)
+    : QObject(parent), m_model(model), m_path(path)
+{
+    connect(&m_timer, &QTimer::timeout, this, &TrackStore::save);
+}
+
+void TrackStore::start(int intervalMs)
+{
+    m_timer.start(intervalMs);
+}
+
+int TrackStore::load(qint64 horizonMs)
+{
+    QFile f(m_path);
+    if (!f.exists())
+        return 0;
+    if (!f.open(QIODevice::ReadOnly)) {
+        qWarning() << "[store] cannot open" << m_path << f.errorString();
+        return 0;
+    }
+
+    QElapsedTimer t;
+    t.start();
+
+    const qint64 size = f.size();
+    const uchar* d = size >= kHeaderSize ? f.map(0, size) : nullptr;
+    if (!d) {
+        qWarning() << "[store] unreadable snapshot" << m_path;
+        return 0;
+    }
+
+    const quint32 version    = qFromLittleEndian<quint32>(d + 8);
+    const quint32 recordSize = qFromLittleEndian<quint32>(d + 12);
+    const quint32 count      = qFromLittleEndian<quint32>(d + 16);
+
+    if (memcmp(d, kMagic, 8) != 0 || version == 0 || version > kVersion || recordSize < quint32(kRecordSize) ||
+        quint64(count) * recordSize > quint64(size - kHeaderSize)) {
+        qWarning() << "[store] bad snapshot header" << m_path << "version" << version;
+        f.unmap(const_cast<uchar*>(d));
+        return 0;
+    }
+
+    const qint64 cutoff = QDateTime::currentMSecsSinceEpoch() - horizonMs;
+
+    QVector<FlightModel::Item> items;
+    items.reserve(int(count));
+    QSet<quint32> seen;
+
+    for (quint32 i = 0; i < count; ++i) {
+        const uchar* r = d + kHeaderSize + quint64(i) * recordSize;
+
+        const qint64 lastSeenMs = qFromLittleEndian<qint64>(r + 24);
+        if (lastSeenMs < cutoff)
+            continue;
+
+        FlightModel::Item it;
+        it.rec.flightId        = qFromLittleEndian<quint32>(r + 0);
+        it.rec.typeId          = r[4];
+        it.rec.srcAirportId    = r[5];
+        it.rec.dstAirportId    = r[6];
+        it.arrived             = (r[7] & kFlagArrived) != 0;
+        it.rec.latitudeRaw     = qFromLittleEndian<quint32>(r + 8);
+        it.rec.latitudeFactor  = qFromLittleEndian<quint16>(r + 12);
+        it.rec.longitudeFactor = qFromLittleEndian<quint16>(r + 14);
+        it.rec.longitudeRaw    = qFromLittleEndian<quint32>(r + 16);
+        it.rec.altitude        = qFromLittleEndian<quint32>(r + 20);
+        it.lastSeen            = QDateTime::fromMSecsSinceEpoch(lastSeenMs, QTimeZone::UTC);
+        it.headingDeg          = getDouble(r + 32);
+
+        if (seen.contains(it.rec.flightId) || !it.rec.isValid())
+            continue;
+        seen.insert(it.rec.flightId);
+        items.push_back(it);
+    }
+
+    f.unmap(const_cast<uchar*>(d));
+
+    m_model->restore(items);
+
+    qDebug() << "[store] restored" << items.size() << "of" << count << "tracks in" << t.elapsed() << "ms";
+    return items.size();
+}
+
+void TrackStore::save()
+{
+    if (!m_busy.testAndSetAcquire(0, 1))
+        return;
+
+    const QString path = m_path;
+
+    if (m_publisher) {
+        QThreadPool::globalInstance()->start([this, path]{
+            const TrackPublisher::Reader view = m_publisher->read();
+            if (view->version != m_savedVersion && write(path, view->items))
+                m_savedVersion = view->version;
+            m_busy.storeRelease(0);
+        });
+        return;
+    }
+
+    // Implicitly shared copy: the worker reads it while upsertFlight detaches.
+    const QVector<FlightModel::Item> items = m_model->items();
+
+    QThreadPool::globalInstance()->start([this, items, path]{
+        write(path, items);
+        m_busy.storeRelease(0);
+    });
+}
+
+void TrackStore::saveNow()
+{
+    m_timer.stop();
+    QThreadPool::globalInstance()->waitForDone();
+    write(m_path, m_model->items());
+}
+
+bool TrackStore::write(const QString& path, const QVector<FlightModel::Item>& items)
+{
+    QByteArray buf(kHeaderSize + items.size() * kRecordSize, '\0');
+    uchar* d = reinterpret_cast<uchar*>(buf.data());
+
+    memcpy(d, kMagic, 8);
+    qToLittleEndian<quint32>(kVersion, d + 8);
+    qToLittleEndian<quint32>(kRecordSize, d + 12);
+    qToLittleEndian<quint32>(quint32(items.size()), d + 16);
+    qToLittleEndian<qint64>(QDateTime::currentMSecsSinceEpoch(), d + 24);
+
+    uchar* r = d + kHeaderSize;
+    for (const FlightModel::Item& it : items) {
+        qToLittleEndian<quint32>(it.rec.flightId, r + 0);
+        r[4] = it.rec.typeId;
+        r[5] = it.rec.srcAirportId;
+        r[6] = it.rec.dstAirportId;
+        r[7] = it.arrived ? kFlagArrived : 0;
+        qToLittleEndian<quint32>(it.rec.latitudeRaw, r + 8);
+        qToLittleEndian<quint16>(it.rec.latitudeFactor, r + 12);
+        qToLittleEndian<quint16>(it.rec.longitudeFactor, r + 14);
+        qToLittleEndian<quint32>(it.rec.longitudeRaw, r + 16);
+        qToLittleEndian<quint32>(it.rec.altitude, r + 20);
+        qToLittleEndian<qint64>(it.lastSeen.toMSecsSinceEpoch(), r + 24);
+        putDouble(r + 32, it.headingDeg);
+        r += kRecordSize;
+    }
+
+    QDir().mkpath(QFileInfo(path).absolutePath());
+
+    QSaveFile out(path);
+    if (!out.open(QIODevice::WriteOnly) || out.write(buf) != buf.size() || !out.commit()) {
+        qWarning() << "[store] snapshot write failed" << path << out.errorString();
+        return false;
+    }
+    return true;
+}
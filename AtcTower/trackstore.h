@@ -0,0 +1,49 @@
+#ifndef TRACKSTORE_H
+#define TRACKSTORE_H
+
+#pragma once
+#include <QObject>
+#include <QTimer>
+#include <QAtomicInt>
+#include "flightmodel.h"
+
+class TrackPublisher;
+
+// Periodic on-disk snapshot of the FlightModel track table, so a restarted
+// console comes back with headings, arrival state and teleport baselines.
+//
+// File layout (little endian):
+//   header : magic "ATCTRK\0\0", quint32 version, quint32 recordSize,
+//            quint32 count, quint32 reserved, qint64 savedAtMs
+//   record : fixed recordSize bytes per track, see trackstore.cpp
+class TrackStore : public QObject {
+    Q_OBJECT
+public:
+    // Tracks not heard from for this long are treated as gone and not restored.
+    static constexpr qint64 kHorizonMs = 5 * 60 * 1000;
+
+    explicit TrackStore(FlightModel* model, const QString& path, QObject* parent=nullptr);
+
+    int  load(qint64 horizonMs = kHorizonMs);
+    void start(int intervalMs);
+
+    // When set, periodic saves read the published view on the worker thread
+    // instead of copying the model on the GUI thread.
+    void setPublisher(TrackPublisher* publisher) { m_publisher = publisher; }
+
+public slots:
+    void save();       // serializes on the thread pool
+    void saveNow();    // blocking, for shutdown
+
+private:
+    static bool write(const QString& path, const QVector<FlightModel::Item>& items);
+
+    FlightModel* m_model;
+    TrackPublisher* m_publisher = nullptr;
+    quint64      m_savedVersion = 0;   // worker only
+    QString      m_path;
+    QTimer       m_timer;
+    QAtomicInt   m_busy;
+};
+
+#endif // TRACKSTORE_H